@@ -0,0 +1,76 @@
+#include "boot/bootprofile.h"
+#include "debug/klog.h"
+#include "machine/core.h"
+#include "machine/tsc.h"
+#include "utils/string.h"
+
+namespace BootProfile {
+
+static struct {
+	uint64_t tsc;
+	const char *phase;
+	unsigned core;
+} marks[MARKS];
+
+static unsigned count = 0;
+
+void mark(const char *phase) {
+	uint64_t tsc = TSC::read();
+	unsigned i = __atomic_fetch_add(&count, 1, __ATOMIC_RELAXED);
+	if (i < MARKS) {
+		marks[i].tsc = tsc;
+		marks[i].core = Core::getID();
+		__atomic_store_n(&marks[i].phase, phase, __ATOMIC_RELEASE);
+	}
+}
+
+static unsigned marked(const char *phase) {
+	unsigned n = __atomic_load_n(&count, __ATOMIC_RELAXED);
+	if (n > MARKS) {
+		n = MARKS;
+	}
+	unsigned found = 0;
+	for (unsigned i = 0; i < n; i++) {
+		const char *p = __atomic_load_n(&marks[i].phase, __ATOMIC_ACQUIRE);
+		if (p != nullptr && strcmp(p, phase) == 0) {
+			found++;
+		}
+	}
+	return found;
+}
+
+bool await(const char *phase, unsigned n, unsigned timeout_ms) {
+	uint64_t start = TSC::read();
+	uint64_t timeout = static_cast<uint64_t>(TSC::ticks()) * timeout_ms;
+	while (marked(phase) < n) {
+		if (TSC::read() - start > timeout) {
+			return false;
+		}
+		Core::pause();
+	}
+	return true;
+}
+
+void report() {
+	unsigned n = __atomic_load_n(&count, __ATOMIC_RELAXED);
+	if (n > MARKS) {
+		n = MARKS;
+	}
+	for (unsigned i = 0; i < n; i++) {
+		// skip a mark which is still being written
+		if (__atomic_load_n(&marks[i].phase, __ATOMIC_ACQUIRE) == nullptr) {
+			continue;
+		}
+		// previous phase on the same core
+		uint64_t prev = marks[0].tsc;
+		for (unsigned j = 0; j < i; j++) {
+			if (marks[j].phase != nullptr && marks[j].core == marks[i].core) {
+				prev = marks[j].tsc;
+			}
+		}
+		KLog::info("boot: core %u %s took %u us (at %u us)", marks[i].core, marks[i].phase,
+		           TSC::nanoseconds(marks[i].tsc - prev) / 1000, TSC::nanoseconds(marks[i].tsc - marks[0].tsc) / 1000);
+	}
+}
+
+}  // namespace BootProfile
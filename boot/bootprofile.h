@@ -0,0 +1,48 @@
+/*! \file
+ *  \brief \ref BootProfile records the duration of the initialization phases
+ */
+
+#pragma once
+
+#include "types.h"
+
+/*! \brief Boot-time profiler
+ *
+ * Each initialization phase is completed by a call to \ref mark, which
+ * stores the timestamp counter along with the (static) phase name and the
+ * core. As the TSC frequency is unknown during the early phases, the raw
+ * timestamps are only converted by \ref report -- relative to the first
+ * mark as well as to the preceding mark of the same core.
+ */
+namespace BootProfile {
+
+/*! \brief Maximum number of recorded marks (further ones are ignored)
+ */
+const unsigned MARKS = 32;
+
+/*! \brief Record the end of an initialization phase on the current core
+ *
+ * \param phase Static string naming the phase
+ */
+void mark(const char *phase);
+
+/*! \brief Wait until a phase has been marked a number of times
+ *
+ * Used by the bootstrap processor to include the phases of the application
+ * processors (which are still booting) in the \ref report.
+ *
+ * \param phase Name of the phase (compared by content)
+ * \param n Expected number of marks
+ * \param timeout_ms Give up after this many milliseconds
+ * \return `true` if all marks were recorded in time
+ * \note Requires a calibrated TSC (see \ref TSC::ticks).
+ */
+bool await(const char *phase, unsigned n, unsigned timeout_ms);
+
+/*! \brief Log all recorded phases (via \ref KLog)
+ *
+ * \note Requires a calibrated TSC (see \ref TSC::ticks).
+ */
+void report();
+
+}  // namespace BootProfile
@@ -104,6 +104,12 @@ PAGE_FLAGS_USER equ 1 << 2
 PAGE_FLAGS_HUGE equ 1 << 7
 
 setup_paging:
+	; The application processors use the tables set up by the bootstrap
+	; processor, which might have been modified (see `memory/paging.h`)
+	; in the meantime -- hence they are only filled once.
+	cmp dword [paging_level4_table], 0
+	jne paging_enable
+
 	; Unlike in Protected Mode, an entry in the page table has a size of 8 bytes
 	; (vs 4 bytes), so there are only 512 (and not 1024) entries per table.
 	; Structure of the 3-level PAE paging: One entry in the
@@ -1,4 +1,5 @@
 #include "boot/multiboot/data.h"
+#include "utils/string.h"
 
 /*! \brief Multiboot Information Structure according to Specification
  * \see [Multiboot Specification]{#multiboot}
@@ -147,6 +148,51 @@ char * getBootLoader() {
 	return reinterpret_cast<char*>(static_cast<uintptr_t>(multiboot_addr->boot_loader_name));
 }
 
+// Call visit for a zero terminated string
+static void visitString(void (*visit)(uintptr_t from, uintptr_t to), const char * string) {
+	if (string != nullptr) {
+		uintptr_t address = reinterpret_cast<uintptr_t>(string);
+		visit(address, address + strlen(string) + 1);
+	}
+}
+
+void visitBootData(void (*visit)(uintptr_t from, uintptr_t to)) {
+	if (multiboot_addr == nullptr) {
+		return;
+	}
+	uintptr_t info = reinterpret_cast<uintptr_t>(multiboot_addr);
+	visit(info, info + sizeof(multiboot_info));
+
+	if (multiboot_addr->has(multiboot_info::Flag::CmdLine)) {
+		visitString(visit, getCommandLine());
+	}
+	if (multiboot_addr->has(multiboot_info::Flag::BootLoaderName)) {
+		visitString(visit, getBootLoader());
+	}
+	if (multiboot_addr->has(multiboot_info::Flag::MemoryMap)) {
+		visit(multiboot_addr->mmap.addr, multiboot_addr->mmap.addr + multiboot_addr->mmap.size);
+	}
+	if (multiboot_addr->has(multiboot_info::Flag::DriveInfo)) {
+		visit(multiboot_addr->drives.addr, multiboot_addr->drives.addr + multiboot_addr->drives.size);
+	}
+	if (multiboot_addr->has(multiboot_info::Flag::Modules)) {
+		uintptr_t table = multiboot_addr->mods.addr;
+		visit(table, table + multiboot_addr->mods.size * sizeof(Module));
+		for (unsigned i = 0; i < multiboot_addr->mods.size; i++) {
+			visitString(visit, getModule(i)->getCommandLine());
+		}
+	}
+	if (multiboot_addr->has(multiboot_info::Flag::VbeInfo)) {
+		// sizes of the VbeInfoBlock and the ModeInfoBlock according to the VBE specification
+		visit(multiboot_addr->vbe.control_info, multiboot_addr->vbe.control_info + 512);
+		visit(multiboot_addr->vbe.mode_info, multiboot_addr->vbe.mode_info + 256);
+	}
+	if (multiboot_addr->has(multiboot_info::Flag::FramebufferInfo)) {
+		uint64_t address = multiboot_addr->framebuffer.address;
+		visit(address, address + static_cast<uint64_t>(multiboot_addr->framebuffer.pitch) * multiboot_addr->framebuffer.height);
+	}
+}
+
 VBE * getVesaBiosExtensionInfo() {
 	if (multiboot_addr != nullptr && multiboot_addr->has(multiboot_info::Flag::VbeInfo)) {
 		return &(multiboot_addr->vbe);
@@ -106,6 +106,18 @@ char * getCommandLine();
  */
 char * getBootLoader();
 
+/*! \brief Enumerate the memory occupied by the information of the boot loader
+ *
+ * Calls \p visit for the multiboot information structure itself and for all
+ * data referenced by it -- the command lines, the memory map, the module table,
+ * the VBE information and the framebuffer -- but not for the contents of the
+ * modules. A memory allocator must not hand out these ranges, since they are
+ * still read after its initialization.
+ *
+ * \param visit Function called with each range `[from, to)`
+ */
+void visitBootData(void (*visit)(uintptr_t from, uintptr_t to));
+
 /*! \brief Memory Map
  *
  * The boot loader queries the BIOS for a memory map and stores its result in
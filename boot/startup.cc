@@ -1,6 +1,7 @@
 #include "startup.h"
 
 #include "types.h"
+#include "boot/bootprofile.h"
 #include "compiler/libc.h"
 #include "debug/output.h"
 #include "debug/kernelpanic.h"
@@ -18,6 +19,11 @@ static bool is_bootstrap_processor = true;
 extern "C" [[noreturn]] void kernel_init() {
 	if (is_bootstrap_processor) {
 		is_bootstrap_processor = false;
+
+		// Provisional per-core data area until Core::init() knows the real ID
+		Core::setLocal(0);
+		BootProfile::mark("kernel entry");
+
 		/* Setup and load Interrupt Descriptor Table (IDT)
 		 *
 		 * On the first call to \ref kernel_init(), we have to assign the
@@ -51,6 +57,7 @@ extern "C" [[noreturn]] void kernel_init() {
 
 		// Initialize the Bootstrap Processor
 		Core::init();
+		BootProfile::mark("IDT, ACPI & APIC");
 
 		// Go to main function
 		main();
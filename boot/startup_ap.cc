@@ -3,10 +3,11 @@
 #include "utils/size.h"
 #include "debug/output.h"
 #include "debug/assert.h"
+#include "interrupt/remotecall.h"
 #include "machine/lapic.h"
 #include "machine/core_interrupt.h"
 #include "machine/gdt.h"
-#include "machine/pit.h"
+#include "machine/tsc.h"
 
 namespace ApplicationProcessor {
 
@@ -56,28 +57,60 @@ void relocateSetupCode() {
 	relocated_ap_gdtd->set(relocated_ap_gdt, size(ap_gdt));
 }
 
-void boot(void) {
+// Timestamp of the INIT IPI
+static uint64_t init_tsc = 0;
+
+// Set once the bootstrap processor has finished the system initialization
+static bool released = false;
+
+void init() {
 	assert(!Core::Interrupt::isEnabled() && "Interrupts should not be enabled before APs have booted!");
 
 	// Relocate setup code
 	relocateSetupCode();
 
-	// Calculate Init-IPI vector based on address of relocated setup_ap()
-	uint8_t vector = RELOCATED_SETUP >> 12;
-
 	// Send Init-IPI to all APs
 	LAPIC::IPI::sendInit();
+	init_tsc = TSC::read();
+}
 
-	// wait at least 10ms
-	PIT::delay(10000);
+void startup() {
+	assert(!Core::Interrupt::isEnabled() && "Interrupts should not be enabled before APs have booted!");
+
+	// Calculate Init-IPI vector based on address of relocated setup_ap()
+	uint8_t vector = RELOCATED_SETUP >> 12;
+
+	// wait at least 10ms after the Init-IPI (calibration is a no-op if already done)
+	uint64_t elapsed = TSC::read() - init_tsc;
+	uint64_t required = TSC::ticks() * 10ULL;
+	if (elapsed < required) {
+		TSC::delay(TSC::nanoseconds(required - elapsed) / 1000 + 1);
+	}
 
 	// Send Startup-IPI twice
 	DBG_VERBOSE << "Sending STARTUP IPI #1" << endl;
 	LAPIC::IPI::sendStartup(vector);
 	// wait at least 200us
-	PIT::delay(200);
+	TSC::delay(200);
 
 	DBG_VERBOSE << "Sending STARTUP IPI #2" << endl;
 	LAPIC::IPI::sendStartup(vector);
 }
+
+void boot(void) {
+	init();
+	startup();
+}
+
+void release() {
+	__atomic_store_n(&released, true, __ATOMIC_RELEASE);
+}
+
+void wait() {
+	while (!__atomic_load_n(&released, __ATOMIC_ACQUIRE)) {
+		// interrupts are still disabled, but e.g. TLB shootdowns must not stall
+		RemoteCall::poll();
+		Core::pause();
+	}
+}
 }  // namespace ApplicationProcessor
@@ -42,9 +42,39 @@ namespace ApplicationProcessor {
 	 *
 	 * Performs relocation by calling \ref relocateSetupCode()
 	 *
+	 * Equivalent to \ref init() followed by \ref startup().
+	 *
 	 * \see [ISDMv3, 8.4.4.2 Typical AP Initialization Sequence](intel_manual_vol3.pdf#page=276)
 	 */
 	void boot();
+
+	/*! \brief First half of \ref boot(): Relocate the setup code and send the INIT IPI
+	 *
+	 * The application processors require at least 10 ms before they accept
+	 * the STARTUP IPI -- time which can be used for other initialization
+	 * (e.g. the timer calibration) instead of busy waiting.
+	 */
+	void init();
+
+	/*! \brief Second half of \ref boot(): Send the STARTUP IPIs
+	 *
+	 * Waits for the remainder of the 10 ms since \ref init(), if necessary.
+	 * The application processors then start in parallel to the caller and
+	 * enter `main_ap()`, which should \ref wait() for the bootstrap processor
+	 * to finish the system initialization.
+	 */
+	void startup();
+
+	/*! \brief Allow the application processors to leave \ref wait()
+	 */
+	void release();
+
+	/*! \brief Spin until the bootstrap processor has called \ref release()
+	 *
+	 * Meanwhile, \ref RemoteCall "remote calls" (e.g. TLB shootdowns of
+	 * \ref Paging) are executed by polling.
+	 */
+	void wait();
 }  // namespace ApplicationProcessor
 
 /*! \brief Begin of setup code for application processors
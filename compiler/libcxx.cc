@@ -3,14 +3,41 @@
  */
 
 #include "types.h"
+#include "memory/heap.h"
+#include "utils/alloc.h"
+
+void *operator new(size_t size) {
+#ifdef HEAPPROF
+	return Heap::allocateFor(size, __builtin_return_address(0));
+#else
+	return malloc(size);
+#endif
+}
+
+void *operator new[](size_t size) {
+#ifdef HEAPPROF
+	return Heap::allocateFor(size, __builtin_return_address(0));
+#else
+	return malloc(size);
+#endif
+}
 
 void operator delete(void *ptr) {
-	(void) ptr;
+	free(ptr);
+}
+
+void operator delete[](void *ptr) {
+	free(ptr);
 }
 
 void operator delete(void *ptr, size_t size) {
-	(void) ptr;
 	(void) size;
+	free(ptr);
+}
+
+void operator delete[](void *ptr, size_t size) {
+	(void) size;
+	free(ptr);
 }
 
 extern "C" int __cxa_atexit(void (*func)(void *), void * arg, void * dso_handle) {
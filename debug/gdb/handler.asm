@@ -75,7 +75,9 @@ gdb_interrupt_entry_%1:
 	call gdb_interrupt_handler
 
 	; restore context from stack
-	pop gs
+	; (skipping gs, as reloading the selector would reset the GS base
+	; pointing to the per-core data area -- see Core::Local)
+	add rsp, 8
 	pop fs
 
 	pop r15
@@ -26,6 +26,11 @@
 
 #include "debug/assert.h"
 #include "debug/output.h"
+#include "interrupt/irqlatency.h"
+#include "interrupt/irqstat.h"
+#include "memory/heapprofile.h"
+#include "object/outputstream.h"
+#include "sync/lockstat.h"
 
 // ASCII characters for hexadecimal representation
 static const char digits[] = "0123456789abcdef";
@@ -59,6 +64,26 @@ static bool stringCompare(const char * a, const char * b, size_t len) {
 	return false;
 }
 
+/*!\brief Exact comparison of a monitor command
+ *
+ * In contrast to \ref stringCompare, prefixes of `name` (like `l` for `locks`)
+ * and extensions of it (like `latency reset` for `latency`) do not match.
+ *
+ * \param command received command
+ * \param name command to check for
+ * \return `true` if identical
+ */
+static bool commandIs(const char * command, const char * name) {
+	while (*command == *name) {
+		if (*command == '\0') {
+			return true;
+		}
+		command++;
+		name++;
+	}
+	return false;
+}
+
 /*!\brief Copy string (including `\0`)
  *
  * \param target Pointer to target buffer
@@ -578,6 +603,56 @@ int GDB_Stub::readString(char *buf, size_t buf_len, size_t len) {
 	return 0;
 }
 
+class GDB_Stub::MonitorStream : public OutputStream {
+	GDB_Stub &stub;
+
+ public:
+	explicit MonitorStream(GDB_Stub &stub) : stub(stub) {}
+
+	void flush() {
+		char buf[1 + 2 * sizeof(Stringbuffer::buffer)];
+		buf[0] = 'O';
+		int len = encodeHex(buf + 1, sizeof(buf) - 1, Stringbuffer::buffer, Stringbuffer::pos);
+		if (len > 0) {
+			stub.sendPacket(buf, 1 + len);
+		}
+		Stringbuffer::pos = 0;
+	}
+};
+
+void GDB_Stub::monitor(const char *command) {
+	MonitorStream out(*this);
+#ifdef LOCKSTAT
+	if (commandIs(command, "locks")) {
+		LockStat::report(out);
+	} else
+#endif
+#ifdef IRQLATENCY
+	if (commandIs(command, "latency")) {
+		IRQLatency::report(out);
+	} else if (commandIs(command, "latency reset")) {
+		IRQLatency::reset();
+	} else
+#endif
+#ifdef HEAPPROF
+	if (commandIs(command, "heap reset")) {
+		// the stopped core might hold the lock
+		if (!HeapProfile::reset(false)) {
+			out << "heap profile busy" << endl;
+		}
+	} else
+#endif
+	if (commandIs(command, "interrupts")) {
+		IRQStat::report(out);
+	} else if (commandIs(command, "heap")) {
+		HeapProfile::report(out, false);
+	} else {
+		out << "unknown monitor command: " << command << endl;
+	}
+	out.flush();
+	sendOkPacket();
+}
+
 void GDB_Stub::handle(void) {
 	uintptr_t addr = 0;
 	static char pkt_buf[2048];
@@ -662,6 +737,16 @@ void GDB_Stub::handle(void) {
 					stringConcat(pkt_buf, sizeof(pkt_buf), "202f204c4150494320233");  // " / LAPIC: "
 					length = stringConcat(pkt_buf, sizeof(pkt_buf), APIC::getLAPICID(addr - 1) + '0');
 					sendPacket(pkt_buf, length);
+				} else if (stringCompare(pkt_buf, "qRcmd,", pkt_len)) {  // [qRcmd,Command] monitor command
+					static char command[128];
+					ptr_next += 6;
+					length = token_remaining_buf / 2;
+					if (length >= sizeof(command) ||
+					    decodeHex(ptr_next, token_remaining_buf, command, length) == -1) {
+						goto error;
+					}
+					command[length] = '\0';
+					monitor(command);
 				} else {  // Unsupported function
 					sendPacket(nullptr, 0);
 				}
@@ -81,10 +81,11 @@ class GDB_Stub : public Serial {
 	 * \param wait Wait for a GDB connection after configuration
 	 * \param debug_output Debug the stub by printing the communication on the DBG output
 	 *                     (could be useful while extending the RSP)
-	 * \param port COM port for the serial connection
+	 * \param port COM port for the serial connection -- must not be the one
+	 *             of the \ref SerialDevice (`COM1`), which consumes all input
 	 * \param baud_rate Baud Rate, default for GDB is `9600` (can be a bottleneck)
 	 */
-	explicit GDB_Stub(bool wait = false, bool debug_output = false, ComPort port = COM1, BaudRate baud_rate = BAUD_9600);
+	explicit GDB_Stub(bool wait = false, bool debug_output = false, ComPort port = COM2, BaudRate baud_rate = BAUD_9600);
 
  protected:
 	/*! \brief Handling traps
@@ -168,6 +169,27 @@ class GDB_Stub : public Serial {
 	 */
 	int sendOkPacket();
 
+	/*! \brief Output stream sending console output packets (`O [hex]`)
+	 *
+	 * Used to answer `monitor` commands.
+	 */
+	class MonitorStream;
+
+	/*! \brief Execute a `monitor` command (received as `qRcmd` packet)
+	 *
+	 * Supported commands:
+	 *  - `locks`: print the \ref LockStat report (requires `-DLOCKSTAT`)
+	 *  - `interrupts`: print the \ref IRQStat counters (including the
+	 *    handover latency of the \ref IRQThread "interrupt threads")
+	 *  - `latency`: print the \ref IRQLatency histograms, `latency reset`
+	 *    clears them (requires `-DIRQLATENCY`)
+	 *  - `heap`: print the \ref HeapProfile report (including the profile
+	 *    with `-DHEAPPROF`), `heap reset` clears the profile's counters
+	 *
+	 * \param command Decoded command string
+	 */
+	void monitor(const char *command);
+
 	/*! \brief Create and send a signal packet (`S [int]`)
 	 *
 	 * \param buf Pointer to buffer
@@ -0,0 +1,216 @@
+#include "debug/klog.h"
+#include "syscall/guarded_vfs.h"
+
+namespace KLog {
+
+volatile Level threshold = INFO;
+
+static struct cache_aligned Ring {
+    Record record[SIZE];
+    // Next slot to be written (only modified by the owning core)
+    volatile unsigned head;
+    // Records lost due to a full ring (only modified by the owning core)
+    uint64_t dropped;
+    // Next slot to be read (only modified by the consumer)
+    cache_aligned volatile unsigned tail;
+} ring[Core::MAX];
+
+namespace {
+// Appends everything flushed to a file
+class FileStream : public OutputStream {
+ public:
+    int fd = -1;
+
+    void flush() override {
+        if (fd >= 0)
+            GuardedVFS::write(fd, Stringbuffer::buffer, Stringbuffer::pos);
+        Stringbuffer::pos = 0;
+    }
+};
+
+struct Sink {
+    OutputStream *volatile stream;
+    volatile Level level;
+};
+}  // namespace
+
+static FileStream file;
+static Sink sinks[SINKS];
+
+// Marks a slot claimed by attach() whose level is not yet set
+static OutputStream *const RESERVED = reinterpret_cast<OutputStream *>(1);
+
+// Stream of an attached sink (or nullptr)
+static OutputStream *streamOf(const Sink &sink) {
+    OutputStream *stream = __atomic_load_n(&sink.stream, __ATOMIC_ACQUIRE);
+    return stream == RESERVED ? nullptr : stream;
+}
+
+// Number of dropped records already reported to the sinks
+static uint64_t reported = 0;
+
+bool append(Level level, const char *fmt, const uint64_t *arg, unsigned args) {
+    bool enabled = Core::Interrupt::disable();
+    Ring &r = ring[Core::getID()];
+    unsigned head = r.head;
+    bool free = head - __atomic_load_n(&r.tail, __ATOMIC_ACQUIRE) < SIZE;
+    if (free) {
+        Record &record = r.record[head % SIZE];
+        record.tsc = TSC::read();
+        record.fmt = fmt;
+        for (unsigned i = 0; i < args; i++)
+            record.arg[i] = arg[i];
+        record.level = level;
+        record.args = args;
+        // publish the record to the consumer
+        __atomic_store_n(&r.head, head + 1, __ATOMIC_RELEASE);
+    } else {
+        r.dropped++;
+    }
+    Core::Interrupt::restore(enabled);
+    return free;
+}
+
+bool attach(OutputStream *stream, Level level) {
+    for (Sink &sink : sinks) {
+        OutputStream *expected = nullptr;
+        // claim the slot first, its level has to be valid once the stream is visible
+        if (__atomic_compare_exchange_n(&sink.stream, &expected, RESERVED, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            sink.level = level;
+            __atomic_store_n(&sink.stream, stream, __ATOMIC_RELEASE);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool attach(const char *path, Level level) {
+    if (file.fd >= 0)
+        return false;
+    int fd = VFS::open(path, O_WRONLY | O_CREAT);
+    if (fd < 0)
+        return false;
+    VFS::lseek(fd, 0, SEEK_END);
+    file.fd = fd;
+    if (!attach(&file, level)) {
+        file.fd = -1;
+        VFS::close(fd);
+        return false;
+    }
+    return true;
+}
+
+void detach(OutputStream *stream) {
+    for (Sink &sink : sinks) {
+        OutputStream *expected = stream;
+        __atomic_compare_exchange_n(&sink.stream, &expected, nullptr, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    }
+}
+
+void setLevel(OutputStream *stream, Level level) {
+    for (Sink &sink : sinks)
+        if (sink.stream == stream)
+            sink.level = level;
+}
+
+uint64_t dropped() {
+    uint64_t sum = 0;
+    for (const Ring &r : ring)
+        sum += r.dropped;
+    return sum;
+}
+
+static void print(OutputStream &out, const Record &record, unsigned core) {
+    static const char tag[] = { 'E', 'W', 'I', 'D' };
+    out << '[' << record.tsc << "] " << core << ' ' << tag[record.level] << ": ";
+    unsigned a = 0;
+    for (const char *c = record.fmt; *c != '\0'; c++) {
+        if (*c != '%' || c[1] == '\0') {
+            out << *c;
+            continue;
+        }
+        c++;
+        if (*c == '%') {
+            out << '%';
+            continue;
+        }
+        if (a >= record.args) {
+            out << "<?>";
+            continue;
+        }
+        uint64_t value = record.arg[a++];
+        switch (*c) {
+            case 'd':
+                out << static_cast<long long>(value);
+                break;
+            case 'u':
+                out << static_cast<unsigned long long>(value);
+                break;
+            case 'x':
+                out << hex << static_cast<unsigned long long>(value) << dec;
+                break;
+            case 'p':
+                out << reinterpret_cast<const void *>(value);
+                break;
+            case 'c':
+                out << static_cast<char>(value);
+                break;
+            case 's':
+                out << (value != 0 ? reinterpret_cast<const char *>(value) : "(null)");
+                break;
+            default:
+                out << '%' << *c;
+        }
+    }
+    out << '\n';
+}
+
+unsigned drain() {
+    // Only consume what is there right now, so a busy core cannot keep us here
+    unsigned head[Core::MAX];
+    for (unsigned i = 0; i < Core::MAX; i++)
+        head[i] = __atomic_load_n(&ring[i].head, __ATOMIC_ACQUIRE);
+
+    unsigned n = 0;
+    while (true) {
+        // merge by timestamp
+        unsigned core = Core::MAX;
+        for (unsigned i = 0; i < Core::MAX; i++) {
+            if (ring[i].tail != head[i] &&
+                (core == Core::MAX || ring[i].record[ring[i].tail % SIZE].tsc < ring[core].record[ring[core].tail % SIZE].tsc))
+                core = i;
+        }
+        if (core == Core::MAX)
+            break;
+
+        Ring &r = ring[core];
+        const Record &record = r.record[r.tail % SIZE];
+        for (const Sink &sink : sinks) {
+            OutputStream *stream = streamOf(sink);
+            if (stream != nullptr && record.level <= sink.level)
+                print(*stream, record, core);
+        }
+        // hand the slot back to the producer
+        __atomic_store_n(&r.tail, r.tail + 1, __ATOMIC_RELEASE);
+        n++;
+    }
+
+    uint64_t lost = dropped();
+    if (lost != reported) {
+        for (const Sink &sink : sinks) {
+            OutputStream *stream = streamOf(sink);
+            if (stream != nullptr)
+                *stream << "[klog] " << (lost - reported) << " records dropped\n";
+        }
+        reported = lost;
+    }
+
+    for (const Sink &sink : sinks) {
+        OutputStream *stream = streamOf(sink);
+        if (stream != nullptr)
+            stream->flush();
+    }
+    return n;
+}
+
+}  // namespace KLog
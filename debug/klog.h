@@ -0,0 +1,182 @@
+/*! \file
+ *  \brief \ref KLog "Kernel log" with per-core lock-free record buffers
+ */
+
+#pragma once
+
+#include "types.h"
+#include "machine/cache.h"
+#include "machine/core.h"
+#include "machine/tsc.h"
+#include "object/outputstream.h"
+
+/*! \brief Non-blocking kernel log
+ *  \ingroup io
+ *
+ * Unlike \ref DBG, logging does not format anything on the caller's side:
+ * \ref log merely stores a timestamped binary record -- the (static) format
+ * string and up to \ref ARGS raw arguments -- in a ring buffer of the
+ * current core. Each ring has a single producer (its core, with interrupts
+ * disabled) and a single consumer (the \ref LogThread), hence no lock is
+ * required on either side. If a ring is full, the record is dropped and
+ * accounted for.
+ *
+ * The \ref LogThread periodically calls \ref drain, which merges the records
+ * of all cores by timestamp, formats them and hands them to every attached
+ * sink (a \ref TextStream, the \ref SerialStream or a file in the \ref VFS)
+ * whose level permits it.
+ *
+ * The format string supports `%d`, `%u`, `%x`, `%p`, `%c`, `%s` (only
+ * for strings which outlive the record, e.g. literals) and `%%`.
+ *
+ * \code{.cpp}
+ *  KLog::info("core %u: %u bytes lost", Core::getID(), n);
+ * \endcode
+ */
+namespace KLog {
+
+/*! \brief Severity of a record (lower is more severe)
+ */
+enum Level : uint8_t {
+	ERROR,
+	WARN,
+	INFO,
+	DEBUG,
+};
+
+/// Maximum number of arguments per record
+const unsigned ARGS = 4;
+
+/// Number of records per core
+const unsigned SIZE = 256;
+
+/// Maximum number of attached sinks
+const unsigned SINKS = 4;
+
+/*! \brief Binary log record (exactly one cache line)
+ */
+struct cache_aligned Record {
+	/// Timestamp in TSC ticks
+	uint64_t tsc;
+	/// Static format string
+	const char *fmt;
+	/// Raw arguments
+	uint64_t arg[ARGS];
+	/// Severity
+	Level level;
+	/// Number of valid arguments
+	uint8_t args;
+};
+
+/*! \brief Records with a level above this threshold are discarded right away
+ */
+extern volatile Level threshold;
+
+/*! \brief Change the runtime filter
+ * \param level Most verbose level still recorded
+ */
+inline void setLevel(Level level) {
+	threshold = level;
+}
+
+/*! \brief Append a record to the ring of the current core
+ *
+ * \param level Severity
+ * \param fmt Static format string
+ * \param arg Arguments
+ * \param args Number of arguments
+ * \return `false` if the ring was full and the record has been dropped
+ */
+bool append(Level level, const char *fmt, const uint64_t *arg, unsigned args);
+
+/// Convert a pointer argument to its raw value
+template<typename T>
+inline uint64_t raw(T *value) {
+	return reinterpret_cast<uintptr_t>(value);
+}
+
+/// Convert an integral argument to its raw value (sign extended)
+template<typename T>
+inline uint64_t raw(T value) {
+	return static_cast<uint64_t>(value);
+}
+
+/*! \brief Log a message
+ *
+ * \param level Severity
+ * \param fmt Static format string
+ * \param args Up to \ref ARGS integral or pointer arguments
+ */
+template<typename... Args>
+inline void log(Level level, const char *fmt, Args... args) {
+	static_assert(sizeof...(Args) <= ARGS, "Too many arguments for a log record");
+	if (level > threshold)
+		return;
+	const uint64_t arg[ARGS + 1] = { raw(args)... };
+	append(level, fmt, arg, sizeof...(Args));
+}
+
+/// Log an \ref ERROR message
+template<typename... Args>
+inline void error(const char *fmt, Args... args) {
+	log(ERROR, fmt, args...);
+}
+
+/// Log a \ref WARN message
+template<typename... Args>
+inline void warn(const char *fmt, Args... args) {
+	log(WARN, fmt, args...);
+}
+
+/// Log an \ref INFO message
+template<typename... Args>
+inline void info(const char *fmt, Args... args) {
+	log(INFO, fmt, args...);
+}
+
+/// Log a \ref DEBUG message
+template<typename... Args>
+inline void debug(const char *fmt, Args... args) {
+	log(DEBUG, fmt, args...);
+}
+
+/*! \brief Attach an output stream as sink
+ *
+ * \param stream Target (e.g. `kout`, `dout[0]` or `sout[0]`)
+ * \param level Most verbose level written to this sink
+ * \return `false` if all sink slots are in use
+ */
+bool attach(OutputStream *stream, Level level = INFO);
+
+/*! \brief Attach a file (which is created if necessary) as sink
+ *
+ * The records are appended to the file.
+ *
+ * \note Has to be called on epilogue level.
+ * \param path Path in the \ref VFS
+ * \param level Most verbose level written to this sink
+ * \return `false` if the file could not be opened or all slots are in use
+ */
+bool attach(const char *path, Level level = DEBUG);
+
+/*! \brief Detach a previously attached stream
+ */
+void detach(OutputStream *stream);
+
+/*! \brief Change the level of an attached stream
+ */
+void setLevel(OutputStream *stream, Level level);
+
+/*! \brief Format the pending records of all cores (in timestamp order)
+ *  and write them to the sinks
+ *
+ * \note Must only be called by one thread at a time (the \ref LogThread).
+ * \return Number of records processed
+ */
+unsigned drain();
+
+/*! \brief Number of records dropped due to a full ring
+ */
+uint64_t dropped();
+
+}  // namespace KLog
@@ -7,9 +7,9 @@
 /*! \def DBG_VERBOSE
  * \brief An output stream, which is only displayed in the debug window in verbose mode
  *
- * \note If a serial console has been implemented, the output can be redirected
- *       to the serial stream instead (by changing the macro) -- this makes the
- *       (usually) very large output more readable (since it allows scrolling back)
+ * \note With `-DDBG_SERIAL`, the output is redirected to the serial stream
+ *       instead (see \ref DBG) -- this makes the (usually) very large output
+ *       more readable (since it allows scrolling back)
  */
 #ifdef VERBOSE
 // If VERBOSE is defined, forward everything to \ref DBG
@@ -30,8 +30,16 @@
  * required, therefore `dout` has to be an \ref TextStream object array with the
  * core ID as array index  -- the selection is done via Core::getID()
  *
+ * If compiled with `-DDBG_SERIAL`, the output of each core is sent to the
+ * \ref SerialDevice instead (using the buffered \ref SerialStream `sout`,
+ * hence without waiting for the interface).
  */
+#ifdef DBG_SERIAL
+#define DBG sout[Core::getID()]
+#include "device/serialstream.h"
+#else
 #define DBG dout[Core::getID()]
+#endif
 
 #include "device/textstream.h"
 #include "machine/core.h"
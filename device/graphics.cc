@@ -3,6 +3,8 @@
 #include "boot/multiboot/data.h"
 
 #include "debug/output.h"
+#include "memory/pageframe.h"
+#include "memory/paging.h"
 #include "utils/string.h"
 
 /*! \brief Mode Information of the *Vesa BIOS Extension*
@@ -82,6 +84,24 @@ struct VbeModeInfo {
 Graphics::Graphics(unsigned size, void* frontbuffer, void* backbuffer)
     : buffer_size(size), buffer{frontbuffer, backbuffer}, scanout_buffer(0), refresh(false) {}
 
+Graphics::Graphics() : buffer_size(0), buffer{nullptr, nullptr}, scanout_buffer(0), refresh(false) {}
+
+bool Graphics::allocateBuffers() {
+	if (buffer[0] != nullptr && buffer[1] != nullptr)
+		return true;
+	unsigned order = PageFrame::order(size);
+	buffer[0] = PageFrame::allocate(order);
+	buffer[1] = PageFrame::allocate(order);
+	if (buffer[0] == nullptr || buffer[1] == nullptr) {
+		PageFrame::free(buffer[0], order);
+		PageFrame::free(buffer[1], order);
+		buffer[0] = buffer[1] = nullptr;
+		return false;
+	}
+	buffer_size = PageFrame::SIZE << order;
+	return true;
+}
+
 bool Graphics::init(bool force) {
 	// Most boot loaders support the Vesa BIOS Extension (VBE) information quite well
 	Multiboot::VBE * vbe = Multiboot::getVesaBiosExtensionInfo();
@@ -97,11 +117,15 @@ bool Graphics::init(bool force) {
 			if (printer != nullptr) {
 				address = reinterpret_cast<void*>(static_cast<uintptr_t>(vbe_info->address));
 				size = vbe_info->height * vbe_info->pitch;
-				if (size > buffer_size) {
+				if (!allocateBuffers()) {
+					DBG_VERBOSE << "Unable to allocate the graphic buffers (2 x " << size << " bytes)!" << endl;
+					return false;
+				} else if (size > buffer_size) {
 					DBG_VERBOSE << "The current graphic buffer (" << buffer_size << " bytes) is too small (at least "
 					            << size << " bytes required)!"  << endl;
 					return false;
 				} else {
+					writeCombining(true);
 					printer->init(vbe_info->width, vbe_info->height, vbe_info->pitch);
 					printer->buffer(buffer[1 - scanout_buffer]);
 					return true;
@@ -122,11 +146,15 @@ bool Graphics::init(bool force) {
 			if (printer != nullptr) {
 				address = reinterpret_cast<void*>(static_cast<uintptr_t>(fb->address));
 				size = fb->height * fb->pitch;
-				if (size > buffer_size) {
+				if (!allocateBuffers()) {
+					DBG_VERBOSE << "Unable to allocate the graphic buffers (2 x " << size << " bytes)!" << endl;
+					return false;
+				} else if (size > buffer_size) {
 					DBG_VERBOSE << "The current graphic buffer (" << buffer_size << " bytes) is too small (at least "
 					            << size << " bytes required)!"  << endl;
 					return false;
 				} else {
+					writeCombining(true);
 					printer->init(fb->width, fb->height, fb->pitch);
 					printer->buffer(buffer[1 - scanout_buffer]);
 					return true;
@@ -158,3 +186,12 @@ void Graphics::scanoutFrontbuffer() {
 		refresh = false;
 	}
 }
+
+bool Graphics::writeCombining(bool enable) {
+	uintptr_t from = reinterpret_cast<uintptr_t>(address) & ~(PageFrame::SIZE - 1);
+	uintptr_t to = (reinterpret_cast<uintptr_t>(address) + size + PageFrame::SIZE - 1) & ~(PageFrame::SIZE - 1);
+	Paging::Flags flags = Paging::WRITEABLE | Paging::NO_EXECUTE;
+	if (enable)
+		flags = flags | Paging::WRITE_COMBINING;
+	return Paging::protect(from, to - from, flags);
+}
@@ -63,7 +63,7 @@ class Graphics {
 	/*! \brief Pointer to the two buffers
 	 * (used alternately as front and back buffers)
 	 */
-	void * const buffer[2];
+	void * buffer[2];
 
 	/*! \brief Index of the current front buffer
 	 */
@@ -73,7 +73,21 @@ class Graphics {
 	 */
 	bool refresh;
 
+	/*! \brief Allocate both buffers from the \ref PageFrame "page frame
+	 * allocator" (unless they have been passed to the constructor)
+	 *
+	 * \return `true` if the buffers are available
+	 */
+	bool allocateBuffers();
+
  public:
+	/*! \brief Constructor for buffers sized at runtime
+	 *
+	 * The front and back buffer are allocated by \ref init with the size
+	 * required for the current video mode.
+	 */
+	Graphics();
+
 	/*! \brief Constructor
 	 *
 	 * \param size Size of each buffer
@@ -105,6 +119,18 @@ class Graphics {
 	 */
 	void scanoutFrontbuffer();
 
+	/*! \brief Change the memory type of the video memory
+	 *
+	 * \ref init maps the video memory write-combining (if the CPU supports
+	 * the PAT), which merges the sequential writes of
+	 * \ref scanoutFrontbuffer into full bus transactions. Disabling it
+	 * restores the default memory type (write back).
+	 *
+	 * \param enable Use write-combining
+	 * \return `false` if the mapping could not be changed
+	 */
+	bool writeCombining(bool enable);
+
 	/*! \brief Clear all pixel of the current back buffer
 	 * (set full screen to black)
 	 */
@@ -129,6 +155,14 @@ class Graphics {
 		return printer->height();
 	}
 
+	/*! \brief Bytes of video memory written for a full screen picture
+	 *
+	 * \return Size of a frame in the current video mode
+	 */
+	unsigned frameSize() {
+		return size;
+	}
+
 	/*! \brief Number of horizontal pixels in current resolution
 	 *
 	 * \return Width of the screen in current video mode
@@ -1,9 +1,7 @@
 #include "device/keyboard.h"
 #include "debug/output.h"
-#include "interrupt/plugbox.h"
 #include "machine/apic.h"
 #include "machine/core_interrupt.h"
-#include "machine/ioapic.h"
 #include "machine/ps2controller.h"
 #include "machine/system.h"
 
@@ -12,28 +10,41 @@ Keyboard keyboard{};
 void Keyboard::plugin() {
     PS2Controller::init();
     PS2Controller::drainBuffer();
-    Plugbox::assign(Core::Interrupt::KEYBOARD, this);
-    uint8_t slot = APIC::getIOAPICSlot(APIC::Device::KEYBOARD);
-    IOAPIC::config(slot, Core::Interrupt::KEYBOARD, IOAPIC::LEVEL);
-    IOAPIC::allow(slot);
+    attach(Core::Interrupt::KEYBOARD, APIC::getIOAPICSlot(APIC::Device::KEYBOARD), IOAPIC::LEVEL);
+}
+
+static bool isReboot(const Key &key) {
+    return key.ctrl() && key.alt() && key.scancode == Key::KEY_DEL;
 }
 
 bool Keyboard::prologue() {
+    // the line is unmasked, hence the PollThread is not fetching concurrently
     Key input;
-    if (PS2Controller::fetch(input)) {
-        if (input.ctrl() && input.alt() && input.scancode == Key::KEY_DEL)
+    if (PS2Controller::hasOutput() && PS2Controller::fetch(input)) {
+        if (isReboot(input))
             System::reboot();
-        return pro.produce(input);
+        if (epi.produce(input))
+            __atomic_fetch_add(&prefetched, 1, __ATOMIC_RELAXED);
     }
-    return false;
+    return PollGate::prologue();
 }
 
-void Keyboard::epilogue() {
-    Key k;
-    while (pro.consume(k)) {
-        if (epi.produce(k))
-            semaphore.v();
+unsigned Keyboard::poll(unsigned budget) {
+    unsigned n = 0;
+    unsigned produced = __atomic_exchange_n(&prefetched, 0, __ATOMIC_RELAXED);
+    Key input;
+    for (; n < budget && PS2Controller::hasOutput(); n++) {
+        if (PS2Controller::fetch(input)) {
+            if (isReboot(input))
+                System::reboot();
+            if (epi.produce(input))
+                produced++;
+        }
     }
+    // wake all waiting readers at once
+    if (produced > 0)
+        semaphore.v(produced);
+    return n;
 }
 
 Key Keyboard::getKey() {
@@ -5,7 +5,7 @@
 #pragma once
 
 #include "debug/output.h"
-#include "interrupt/gate.h"
+#include "interrupt/pollgate.h"
 #include "object/bbuffer.h"
 #include "object/key.h"
 #include "sync/semaphore.h"
@@ -16,23 +16,26 @@
  *  \ingroup io
  *
  * This class ensures correct initialization of the keyboard and, above all,
- * its interrupt handling.
+ * its interrupt handling: Being a \ref PollGate, the interrupt only masks
+ * the line and the \ref PollThread fetches the keys in batches -- so key
+ * repeats or pasted input do not cause an interrupt per scan code.
  *
  */
-class Keyboard : public Gate {
+class Keyboard : public PollGate {
 	// Prevent copies and assignments
 	Keyboard(const Keyboard&)            = delete;
 	Keyboard& operator=(const Keyboard&) = delete;
 
  private:
-	BBuffer<Key, BUFFER_SIZE> pro;
 	BBuffer<Key, BUFFER_SIZE> epi;
 	Semaphore semaphore;
+	/// Keys buffered by the prologue, not yet announced to the semaphore
+	unsigned prefetched;
 
  public:
 	/*! \brief Constructor
 	 */
-	Keyboard() : semaphore(0) {}
+	Keyboard() : semaphore(0), prefetched(0) {}
 
 	/*! \brief Destructor
 	 */
@@ -58,8 +61,20 @@ class Keyboard : public Gate {
 	 */
 	void plugin();
 
+	/*! \brief Fetch the first scan code before masking the line
+	 *
+	 * The emergency reboot (Ctrl-Alt-Del) has to work on interrupt level, even
+	 * if the \ref Guard is stuck or the \ref PollThread is starved.
+	 */
 	bool prologue() override;
-	void epilogue() override;
+
+	/*! \brief Fetch up to `budget` scan codes from the \ref PS2Controller
+	 *
+	 * \param budget Maximum number of scan codes
+	 * \return Number of scan codes fetched
+	 */
+	unsigned poll(unsigned budget) override;
+
 	Key getKey();
 };
 
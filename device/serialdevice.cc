@@ -0,0 +1,128 @@
+#include "device/serialdevice.h"
+#include "debug/assert.h"
+#include "machine/apic.h"
+#include "machine/core.h"
+
+SerialDevice serial{};
+
+void SerialDevice::plugin() {
+    // interrupt after 14 received bytes (or a timeout if less are pending)
+    writeReg(FIFO_CONTROL_REGISTER, ENABLE_FIFO | TRIGGER_RECEIVE_14);
+
+    APIC::Device device = (port == COM1 || port == COM3) ? APIC::Device::COM1 : APIC::Device::COM2;
+    attach(Core::Interrupt::SERIAL, APIC::getIOAPICSlot(device), IOAPIC::LEVEL);
+    plugged = true;
+    writeReg(INTERRUPT_ENABLE_REGISTER, RECEIVED_DATA_AVAILABLE);
+
+    // start transmitting data written so far
+    transmit();
+}
+
+bool SerialDevice::prologue() {
+    transmit();
+    if ((readReg(LINE_STATUS_REGISTER) & DATA_READY) != 0)
+        return PollGate::prologue();
+    return false;
+}
+
+unsigned SerialDevice::write(const char *data, unsigned size) {
+    // keep the reservation short (it blocks the transmission of later ones)
+    bool enabled = Core::Interrupt::disable();
+    unsigned head = __atomic_load_n(&tx_head, __ATOMIC_RELAXED);
+    unsigned n;
+    do {
+        unsigned space = TX_SIZE - (head - __atomic_load_n(&tx_tail, __ATOMIC_ACQUIRE));
+        n = size < space ? size : space;
+        if (n == 0)
+            break;
+    } while (!__atomic_compare_exchange_n(&tx_head, &head, head + n, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    for (unsigned i = 0; i < n; i++) {
+        Cell &cell = tx[(head + i) % TX_SIZE];
+        cell.value = data[i];
+        __atomic_store_n(&cell.sequence, head + i + 1, __ATOMIC_RELEASE);
+    }
+    if (n < size)
+        __atomic_fetch_add(&dropped, size - n, __ATOMIC_RELAXED);
+
+    transmit();
+    Core::Interrupt::restore(enabled);
+    return n;
+}
+
+bool SerialDevice::consume(char &value) {
+    unsigned tail = tx_tail;
+    Cell &cell = tx[tail % TX_SIZE];
+    if (__atomic_load_n(&cell.sequence, __ATOMIC_ACQUIRE) != tail + 1)
+        return false;
+    value = cell.value;
+    __atomic_store_n(&tx_tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+void SerialDevice::transmit() {
+    bool enabled = Core::Interrupt::disable();
+    bool again;
+    do {
+        // only a single consumer -- the current one will check again
+        if (__atomic_test_and_set(&transmitting, __ATOMIC_ACQUIRE))
+            break;
+
+        if ((readReg(LINE_STATUS_REGISTER) & TRANSMITTER_HOLDING_REGISTER) != 0) {
+            char value;
+            for (unsigned i = 0; i < FIFO_SIZE && consume(value); i++)
+                writeReg(TRANSMIT_BUFFER_REGISTER, value);
+        }
+
+        // get an interrupt as soon as the FIFO is empty (if there is more)
+        bool more = __atomic_load_n(&tx_head, __ATOMIC_ACQUIRE) != tx_tail;
+        if (plugged)
+            writeReg(INTERRUPT_ENABLE_REGISTER,
+                     RECEIVED_DATA_AVAILABLE | (more ? TRANSMITTER_HOLDING_REGISTER_EMPTY : 0));
+        __atomic_clear(&transmitting, __ATOMIC_RELEASE);
+
+        // data written while holding the flag would be stuck otherwise
+        again = !more && __atomic_load_n(&tx_head, __ATOMIC_ACQUIRE) != __atomic_load_n(&tx_tail, __ATOMIC_ACQUIRE);
+    } while (again);
+    Core::Interrupt::restore(enabled);
+}
+
+unsigned SerialDevice::poll(unsigned budget) {
+    unsigned n = 0;
+    unsigned produced = 0;
+    for (; n < budget; n++) {
+        int c = Serial::read(false);
+        if (c < 0)
+            break;
+        if (received.produce(static_cast<char>(c)))
+            produced++;
+        else
+            overflows++;
+    }
+    if (produced > 0)
+        available.v(produced);
+
+    // the line stays masked while polling, hence no THRE interrupts either
+    transmit();
+    return n;
+}
+
+char SerialDevice::getChar() {
+    available.p();
+    char c = 0;
+    bool b = received.consume(c);
+    assert(b);
+    return c;
+}
+
+unsigned SerialDevice::read(char *data, unsigned size) {
+    if (size == 0)
+        return 0;
+    data[0] = getChar();
+    unsigned n = 1;
+    while (n < size && available.try_p()) {
+        bool b = received.consume(data[n++]);
+        assert(b);
+    }
+    return n;
+}
@@ -0,0 +1,148 @@
+/*! \file
+ *  \brief \ref SerialDevice provides buffered, interrupt-driven access to the \ref Serial interface
+ */
+
+#pragma once
+
+#include "interrupt/pollgate.h"
+#include "machine/serial.h"
+#include "object/bbuffer.h"
+#include "sync/semaphore.h"
+
+/*! \brief Interrupt-driven serial interface with transmit and receive buffers
+ *  \ingroup io
+ *
+ * **Transmission**: \ref write copies the data into a lock-free ring buffer
+ * (multiple producers on any core and level reserve a contiguous range, so
+ * concurrent writes are not interleaved) and returns immediately. The ring
+ * is drained in bursts of up to \ref FIFO_SIZE bytes into the UART's FIFO --
+ * directly by the writer if the FIFO is empty, otherwise by the prologue of
+ * the *transmitter holding register empty* interrupt.
+ *
+ * **Reception**: The receive interrupt is handled as \ref PollGate: under
+ * high input rates, the \ref PollThread drains the receive FIFO in batches
+ * into a buffer instead of taking an interrupt per byte (the FIFO only raises
+ * an interrupt after 14 received bytes or a timeout). Threads read the
+ * received bytes with \ref getChar or \ref read, sleeping on a
+ * \ref Semaphore while no data is available.
+ */
+class SerialDevice : public PollGate, public Serial {
+	// Prevent copies and assignments
+	SerialDevice(const SerialDevice&)            = delete;
+	SerialDevice& operator=(const SerialDevice&) = delete;
+
+ public:
+	/// Size of the transmit FIFO of a 16550 UART
+	static const unsigned FIFO_SIZE = 16;
+
+	/// Capacity of the transmit ring buffer
+	static const unsigned TX_SIZE = 8192;
+
+ private:
+	/// Slot of the transmit ring buffer
+	struct Cell {
+		/// Position of the contained byte plus one (once it is valid)
+		volatile unsigned sequence;
+		char value;
+	};
+	Cell tx[TX_SIZE];
+
+	/// Next position to be reserved by a writer
+	volatile unsigned tx_head;
+
+	/// Next position to be transmitted
+	volatile unsigned tx_tail;
+
+	/// Set while a core fills the transmit FIFO (single consumer)
+	volatile bool transmitting;
+
+	/// Interrupts are enabled (by \ref plugin)
+	bool plugged;
+
+	/// Received bytes
+	BBuffer<char, 4096> received;
+
+	/// Counts the bytes in \ref received
+	Semaphore available;
+
+	/// Bytes lost due to a full buffer
+	uint64_t overflows;
+
+	/// Bytes not transmitted due to a full buffer
+	volatile uint64_t dropped;
+
+	/// Get the next byte of the transmit ring (consumer only)
+	bool consume(char &value);
+
+	/// Fill the transmit FIFO from the ring (if it is empty)
+	void transmit();
+
+ public:
+	/// \copydoc Serial::Serial()
+	explicit SerialDevice(ComPort port = COM1, BaudRate baud_rate = BAUD_115200, DataBits data_bits = DATA_8BIT,
+	                      StopBits stop_bits = STOP_1BIT, Parity parity = PARITY_NONE) :
+		Serial(port, baud_rate, data_bits, stop_bits, parity), tx{}, tx_head(0), tx_tail(0),
+		transmitting(false), plugged(false), available(0), overflows(0), dropped(0) {}
+
+	/*! \brief Enable the interrupts
+	 *
+	 * Registers at the \ref Plugbox and configures the \ref IOAPIC (level
+	 * triggered, as the UART keeps its line asserted until the cause has
+	 * been handled). Before, written data is only transmitted as far as the
+	 * FIFO takes it.
+	 */
+	void plugin();
+
+	/*! \brief Transmit pending data and, if data was received, hand the
+	 *  device over to the \ref PollThread
+	 *
+	 * \return `true` if the \ref PollThread has to be scheduled
+	 */
+	bool prologue() override;
+
+	/*! \brief Move up to `budget` bytes from the UART into the buffer
+	 *
+	 * \param budget Maximum number of bytes
+	 * \return Number of bytes read from the UART
+	 */
+	unsigned poll(unsigned budget) override;
+
+	/*! \brief Queue data for transmission (without waiting)
+	 *
+	 * Can be called from any core and level.
+	 *
+	 * \param data Bytes to send
+	 * \param size Number of bytes
+	 * \return Number of bytes queued (less than `size` if the buffer is full)
+	 */
+	unsigned write(const char *data, unsigned size);
+
+	/*! \brief Get the next received byte (blocks if none is available)
+	 *
+	 * \note Has to be called on epilogue level
+	 */
+	char getChar();
+
+	/*! \brief Read received bytes (blocks until at least one is available)
+	 *
+	 * \note Has to be called on epilogue level
+	 * \param data Buffer for the received bytes
+	 * \param size Size of the buffer
+	 * \return Number of bytes read
+	 */
+	unsigned read(char *data, unsigned size);
+
+	/*! \brief Number of received bytes dropped as the buffer was full
+	 */
+	uint64_t lost() const {
+		return overflows;
+	}
+
+	/*! \brief Number of bytes not sent as the buffer was full
+	 */
+	uint64_t discarded() const {
+		return dropped;
+	}
+};
+
+extern SerialDevice serial;
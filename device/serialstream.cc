@@ -0,0 +1,21 @@
+#include "device/serialstream.h"
+
+SerialStream sout[Core::MAX];
+
+void SerialStream::flush() {
+    char line[2 * sizeof(Stringbuffer::buffer)];
+    unsigned len = 0;
+    for (unsigned long i = 0; i < Stringbuffer::pos; i++) {
+        if (Stringbuffer::buffer[i] == '\n')
+            line[len++] = '\r';
+        line[len++] = Stringbuffer::buffer[i];
+    }
+    device.write(line, len);
+    Stringbuffer::pos = 0;
+}
+
+void SerialStream::reset() {
+    flush();
+    const char clear[] = "\e[2J\e[H";
+    device.write(clear, sizeof(clear) - 1);
+}
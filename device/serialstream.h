@@ -0,0 +1,49 @@
+/*! \file
+ *  \brief \ref SerialStream outputs text via the \ref SerialDevice
+ */
+
+#pragma once
+
+#include "object/outputstream.h"
+#include "device/serialdevice.h"
+#include "machine/core.h"
+
+/*! \brief Output text (from different data type sources) via the serial interface
+ *  \ingroup io
+ *
+ * Like \ref TextStream, but the characters are sent to a \ref SerialDevice
+ * (which allows scrolling back through long reports on the host).
+ * Line breaks are sent as `\r\n`.
+ *
+ * As the \ref SerialDevice transmits from a buffer, flushing does not wait
+ * for the (slow) interface -- and the contents of a flush are never
+ * interleaved with output of other cores.
+ */
+class SerialStream : public OutputStream {
+	// Prevent copies and assignments
+	SerialStream(const SerialStream&)            = delete;
+	SerialStream& operator=(const SerialStream&) = delete;
+
+	SerialDevice &device;
+
+ public:
+	/*! \brief Constructor
+	 *  \param device Serial interface used for the output
+	 */
+	explicit SerialStream(SerialDevice &device = serial) : device(device) {}
+
+	/*! \brief Queue the buffer contents of the base class \ref Stringbuffer
+	 *  for transmission
+	 */
+	void flush();
+
+	/*! \brief Clear the terminal on the host (using ANSI escape sequences)
+	 */
+	void reset();
+};
+
+/*! \brief Serial debug output for each core
+ *
+ * Used by \ref DBG if the kernel is compiled with `-DDBG_SERIAL`.
+ */
+extern SerialStream sout[Core::MAX];
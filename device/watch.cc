@@ -1,14 +1,36 @@
 #include "device/watch.h"
+#include "interrupt/irqbalancer.h"
 #include "interrupt/plugbox.h"
 #include "machine/lapic.h"
+#include "machine/tsc.h"
 #include "sync/bellringer.h"
+#include "sync/rcu.h"
 #include "thread/scheduler.h"
 
 Watch watch{};
 
+// Core local state of the TSC-deadline mode
+static struct cache_aligned {
+    // Timestamp of the next tick
+    uint64_t next;
+    // Deadline currently programmed
+    uint64_t armed;
+    // Whether the last interrupt was a tick (and not just an alarm)
+    bool tick;
+} local[Core::MAX];
+
 bool Watch::windup(uint32_t us) {
     Plugbox::assign(Core::Interrupt::TIMER, this);
+    ival = us;
+    if (LAPIC::Timer::hasDeadline()) {
+        TSC::ticks();
+        deadline = true;
+        period = TSC::fromMicroseconds(us);
+        return period != 0;
+    }
+    // also calibrates the TSC (used by the Bellringer in either mode)
     uint64_t u = static_cast<uint64_t>(us) * LAPIC::Timer::ticks();
+    TSC::ticks();
     u /= 1000;
     uint16_t div;
     for (div = 1; div < UINT8_MAX; div *= 2) {
@@ -19,25 +41,70 @@ bool Watch::windup(uint32_t us) {
     if (div >= UINT8_MAX)
         return false;
     divide = div;
-    ival = us;
     counter = u / divide;
     return true;
 }
 
 bool Watch::prologue() {
+    if (deadline) {
+        auto &l = local[Core::getID()];
+        uint64_t now = TSC::read();
+        l.tick = now >= l.next;
+        if (l.tick) {
+            l.next += period;
+            // skip ticks which have been missed entirely
+            if (l.next <= now)
+                l.next = now + period;
+        }
+        // an expired deadline is cleared by the hardware
+        l.armed = l.next;
+        LAPIC::Timer::arm(l.armed);
+    }
     return true;
 }
 
 void Watch::epilogue() {
-    if (Core::getID() == 0)
+    if (deadline) {
+        Bellringer::check();
+        alarm(Bellringer::next());
+        if (!local[Core::getID()].tick)
+            return;
+    } else if (Core::getID() == 0) {
         Bellringer::check();
-    Scheduler::resume();
+    }
+    if (Core::getID() == 0)
+        IRQBalancer::tick(ival);
+    RCU::check();
+    // do not preempt readers inside an RCU read-side critical section
+    if (!RCU::isReading())
+        Scheduler::resume();
 }
 
 uint32_t Watch::interval() const {
     return ival;
 }
 
-void Watch::activate() const {
-    LAPIC::Timer::set(counter, divide, Core::Interrupt::TIMER, true);
+void Watch::activate() {
+    if (deadline) {
+        auto &l = local[Core::getID()];
+        l.next = TSC::read() + period;
+        l.armed = l.next;
+        LAPIC::Timer::setDeadline(Core::Interrupt::TIMER);
+        LAPIC::Timer::arm(l.armed);
+    } else {
+        LAPIC::Timer::set(counter, divide, Core::Interrupt::TIMER, true);
+    }
+}
+
+void Watch::alarm(uint64_t tsc) {
+    if (!deadline)
+        return;
+    // the prologue modifies the same state
+    bool enabled = Core::Interrupt::disable();
+    auto &l = local[Core::getID()];
+    if (tsc < l.armed) {
+        l.armed = tsc;
+        LAPIC::Timer::arm(tsc);
+    }
+    Core::Interrupt::restore(enabled);
 }
@@ -11,6 +11,13 @@
  *
  * Handles \ref LAPIC::Timer interrupts, therefore managing the time slices and
  * triggering a \ref Scheduler::resume "thread switch" if necessary.
+ *
+ * If the LAPIC supports it, the timer runs in TSC-deadline mode: Each core
+ * keeps the absolute timestamp of its next tick, which is advanced by a
+ * fixed number of TSC ticks (and hence does not drift) and rearmed with a
+ * single MSR write in the prologue. In between, the timer may be armed
+ * earlier to ring a \ref Bell right on time (see \ref alarm).
+ * Otherwise, the periodic countdown mode is used.
  */
 class Watch : public Gate {
 	// Prevent copies and assignments
@@ -22,8 +29,12 @@ class Watch : public Gate {
 	uint8_t divide;
 	uint32_t counter;
 
+	/// Interval in TSC ticks (TSC-deadline mode only)
+	uint64_t period;
+	bool deadline;
+
  public:
-	Watch() : ival(0), divide(0), counter(0) {}
+	Watch() : ival(0), divide(0), counter(0), period(0), deadline(false) {}
 
 	/*! \brief Windup / initialize
 	 *
@@ -34,6 +45,7 @@ class Watch : public Gate {
 	 * based on the timer frequency determined with \ref LAPIC::Timer::ticks().
 	 * This timer divisor has to be as small as possible, but large enough to
 	 * prevent the 32bit counter from overflowing.
+	 * In TSC-deadline mode, the interval is converted to TSC ticks instead.
 	 *
 	 * \param us Desired interrupt interval in microseconds.
 	 * \return Indicates if the interval could be set.
@@ -52,7 +64,12 @@ class Watch : public Gate {
 
 	/*! \brief Epilogue of timer interrupts
 	 *
-	 * Triggers the \ref Scheduler::resume "thread switch".
+	 * Triggers the \ref Scheduler::resume "thread switch" (unless the core
+	 * is inside an \ref RCU read-side critical section) and executes the
+	 * \ref RCU callbacks whose grace period has elapsed.
+	 * Due \ref Bell "bells" are rung on every core (in TSC-deadline mode,
+	 * the interrupt might have been an \ref alarm instead of a tick).
+	 * On core 0, it additionally drives the \ref IRQBalancer.
 	 *
 	 *  \todo Implement Method
 	 */
@@ -75,7 +92,22 @@ class Watch : public Gate {
 	 *
 	 *  \todo Implement method
 	 */
-	void activate() const;
+	void activate();
+
+	/*! \brief Request a timer interrupt on the current core at `tsc`, if it
+	 *  is earlier than the next one already armed
+	 *
+	 * Only has an effect in TSC-deadline mode.
+	 *
+	 * \param tsc Absolute timestamp
+	 */
+	void alarm(uint64_t tsc);
+
+	/*! \brief Check if the timer runs in TSC-deadline mode
+	 */
+	bool isDeadline() const {
+		return deadline;
+	}
 
 };
 
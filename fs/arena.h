@@ -0,0 +1,76 @@
+#pragma once
+
+// Scratch memory for temporary buffers of the filesystem layer.
+// Inside the kernel this is provided by memory/arena.h; the host tool
+// (fstool) keeps each allocation in a malloc'ed block on a stack.
+
+#ifdef FSTOOL
+
+#include "types.h"
+#include "utils/alloc.h"
+
+class Arena {
+	struct Block {
+		Block *prev;
+	};
+
+	// Keeps the allocations 16 byte aligned
+	static const size_t HEADER = 16;
+
+	Block *current;
+
+ public:
+	struct Mark {
+		Block *block;
+	};
+
+	class Scope {
+		Arena &arena;
+		const Mark position;
+
+	 public:
+		explicit Scope(Arena &arena) : arena(arena), position(arena.mark()) {}
+
+		~Scope() {
+			arena.release(position);
+		}
+	};
+
+	Arena() : current(nullptr) {}
+
+	~Arena() {
+		release(Mark{nullptr});
+	}
+
+	void *allocate(size_t size, size_t align = 16) {
+		(void) align;
+		Block *block = static_cast<Block *>(malloc(HEADER + size));
+		if (block == nullptr) {
+			return nullptr;
+		}
+		block->prev = current;
+		current = block;
+		return reinterpret_cast<char *>(block) + HEADER;
+	}
+
+	Mark mark() const {
+		return Mark{current};
+	}
+
+	void release(const Mark &position) {
+		while (current != position.block) {
+			Block *block = current;
+			current = block->prev;
+			free(block);
+		}
+	}
+
+	static Arena &scratch() {
+		static Arena arena;
+		return arena;
+	}
+};
+
+#else
+#include "memory/arena.h"
+#endif
@@ -31,6 +31,17 @@ class BlockDevice {
 	// (currently not implemented for lack of a dirty list)
 	virtual int sync() = 0;
 
+	// Direct access for devices keeping all their blocks in memory (e.g. Ramdisk):
+	// Returns the address of the block, which is followed by the next blocks
+	// up to the end of the device; their number (including this block) is
+	// written into 'count'. No fix/unfix is needed for such addresses.
+	// Returns nullptr if the device does not support direct access (default).
+	virtual void *direct_access(uint64_t block_number, uint64_t *count) {
+		(void) block_number;
+		*count = 0;
+		return nullptr;
+	}
+
 	// Sets the logical blocksize.
 	// This is the number of bytes that will be read/written per 'Block'.
 	// Must not match the physical blocksize.
@@ -2,6 +2,7 @@
 
 #include "types.h"
 #include "fs/inode.h"
+#include "fs/slab.h"
 
 class File {
  public:
@@ -23,4 +24,16 @@ class File {
 	~File() {
 		inode->put();
 	}
+
+	// Files are allocated from their own cache (returns nullptr if out of memory)
+	static SlabCache cache;
+
+	static void *operator new(size_t size) noexcept {
+		(void) size;
+		return cache.allocate();
+	}
+
+	static void operator delete(void *ptr) {
+		cache.deallocate(ptr);
+	}
 };
@@ -1,13 +1,29 @@
 #include "fs/filesystem.h"
+#include "fs/arena.h"
 #include "fs/errno.h"
 #include "fs/util.h"
 #include "fs/definitions.h"
-#include "utils/alloc.h"
 
 static size_t minsize(size_t a, size_t b) {
 	return a < b ? a : b;
 }
 
+// Number of blocks (at most 'limit') starting with 'logical_block' (stored in 'blockno')
+// which are stored in consecutive blocks of the device
+static uint64_t consecutive_blocks(Filesystem *fs, Inode *inode, uint64_t logical_block, uint64_t blockno,
+                                   uint64_t limit) {
+	uint64_t run = 1;
+	while (run < limit) {
+		int error = 0;
+		uint64_t next = fs->get_block(inode, logical_block + run, false, &error);
+		if (error != 0 || next != blockno + run) {
+			break;
+		}
+		run++;
+	}
+	return run;
+}
+
 ssize_t Filesystem::read(Inode *inode, void *buf, size_t count, off_t pos) {
 	Filesystem *fs = inode->filesystem;
 	BlockDevice *bdev = fs->bdev;
@@ -17,6 +33,8 @@ ssize_t Filesystem::read(Inode *inode, void *buf, size_t count, off_t pos) {
 
 	char *to = reinterpret_cast<char *>(buf);
 	size_t bytes_read = 0;
+	// the transfer is split into several copies, hence memcpy would not stream by itself
+	size_t (*copy)(void *, const void *, size_t) = count >= MEMCPY_STREAM_THRESHOLD ? copy_to_user_stream : copy_to_user;
 	while (bytes_read < count) {
 		if (pos + bytes_read >= static_cast<size_t>(inode->size)) {
 			break;
@@ -26,19 +44,36 @@ ssize_t Filesystem::read(Inode *inode, void *buf, size_t count, off_t pos) {
 		if (error != 0) {
 			return error;
 		}
+
+		size_t bytes_left = inode->size - pos - bytes_read;
+		size_t bytes_to_read = count - bytes_read;
+		size_t n = minsize(bytes_left, bytes_to_read);
+
+		uint64_t available;
+		char *direct = reinterpret_cast<char *>(bdev->direct_access(blockno, &available));
+		if (direct != nullptr) {
+			// copy all consecutive blocks at once
+			uint64_t needed = bdev->divide_by_blocksize(offset_in_block + n + blocksize - 1);
+			uint64_t run = consecutive_blocks(fs, inode, logical_block, blockno, minsize(needed, available));
+			n = minsize(run * blocksize - offset_in_block, n);
+			if (copy(to + bytes_read, direct + offset_in_block, n) != n) {
+				return -EFAULT;
+			}
+			bytes_read += n;
+			logical_block += run;
+			offset_in_block = 0;
+			continue;
+		}
+
 		Block block = bdev->fix(blockno);
 		if (block.data == nullptr) {
 			return block.flags;
 		}
 
-		size_t bytes_left = inode->size - pos - bytes_read;
 		size_t remaining_in_block = blocksize - offset_in_block;
-		size_t bytes_to_read = count - bytes_read;
-
-		size_t n = minsize(bytes_left, bytes_to_read);
 		n = minsize(remaining_in_block, n);
 		char *from = reinterpret_cast<char *>(block.data) + offset_in_block;
-		if (copy_to_user(to + bytes_read, from, n) != n) {
+		if (copy(to + bytes_read, from, n) != n) {
 			block.unfix();
 			return -EFAULT;
 		}
@@ -51,6 +86,33 @@ ssize_t Filesystem::read(Inode *inode, void *buf, size_t count, off_t pos) {
 	return bytes_read;
 }
 
+const void *Filesystem::direct_access(Inode *inode, off_t pos, size_t *length, int *error) {
+	BlockDevice *bdev = inode->filesystem->bdev;
+	if (pos < 0 || pos >= inode->size) {
+		*length = 0;
+		return nullptr;
+	}
+	size_t n = minsize(*length, inode->size - pos);
+	uint64_t logical_block = bdev->divide_by_blocksize(pos);
+	unsigned int offset_in_block = bdev->modulo_blocksize(pos);
+
+	int err = 0;
+	uint64_t blockno = get_block(inode, logical_block, false, &err);
+	if (err != 0) {
+		*error = err;
+		return nullptr;
+	}
+	uint64_t available;
+	char *direct = reinterpret_cast<char *>(bdev->direct_access(blockno, &available));
+	if (direct == nullptr) {
+		return nullptr;
+	}
+	uint64_t needed = bdev->divide_by_blocksize(offset_in_block + n + bdev->blocksize - 1);
+	uint64_t run = consecutive_blocks(this, inode, logical_block, blockno, minsize(needed, available));
+	*length = minsize(run * bdev->blocksize - offset_in_block, n);
+	return direct + offset_in_block;
+}
+
 ssize_t Filesystem::write(Inode *inode, const void *buf, size_t count, off_t pos) {
 	Filesystem *fs = inode->filesystem;
 	BlockDevice *bdev = fs->bdev;
@@ -125,10 +187,6 @@ int Filesystem::punch_hole(Inode *inode, off_t from, off_t to) {
 	return 0;
 }
 
-static void symlink_buffer_cleanup(const char *buf) {
-	free(reinterpret_cast<void *>(const_cast<char*>(buf)));
-}
-
 const char *Filesystem::get_link(Inode *inode, void (**cleanup_callback)(const char *buf), int *error) {
 	if (inode->size == 0) {
 		// apparently Posix allows empty symlinks
@@ -138,7 +196,7 @@ const char *Filesystem::get_link(Inode *inode, void (**cleanup_callback)(const c
 		*error = -ENAMETOOLONG;
 		return nullptr;
 	}
-	char *buf = reinterpret_cast<char *>(malloc(inode->size + 1));
+	char *buf = reinterpret_cast<char *>(Arena::scratch().allocate(inode->size + 1, 1));
 	if (buf == nullptr) {
 		*error = -ENOMEM;
 		return nullptr;
@@ -148,7 +206,6 @@ const char *Filesystem::get_link(Inode *inode, void (**cleanup_callback)(const c
 	do {
 		ssize_t retval = read(inode, buf + bytes_read, inode->size - bytes_read, bytes_read);
 		if (retval < 0) {
-			free(buf);
 			*error = retval;
 			return nullptr;
 		}
@@ -157,6 +214,6 @@ const char *Filesystem::get_link(Inode *inode, void (**cleanup_callback)(const c
 
 	// null-terminate for filesystems that don't store a null-terminated string for symlinks
 	buf[inode->size] = 0;
-	*cleanup_callback = symlink_buffer_cleanup;
+	(void) cleanup_callback;
 	return buf;
 }
@@ -39,10 +39,21 @@ class Filesystem {
 
 	// Usually filesystems do not need to implement this!
 	// A generic implementation that uses the filesystem's get_block function is provided
-	// as default in filesystem.cc.
+	// as default in filesystem.cc. On block devices with direct access, each run of
+	// consecutive blocks is copied at once.
 	// buf can be but must not be a user buffer.
 	virtual ssize_t read(Inode *inode, void *buf, size_t count, off_t pos);
 
+	// Returns the address of the bytes [pos, pos + *length) of the inode if the
+	// block device supports direct access (see BlockDevice::direct_access).
+	// '*length' is reduced to the part which is contiguous in memory (and within
+	// the file). Returns nullptr if direct access is not possible; 'error' is only
+	// set (to a negative errno) if looking up the block failed.
+	// The address stays valid as long as the file is neither truncated nor written
+	// and the filesystem stays mounted.
+	// A generic implementation using get_block is provided in filesystem.cc.
+	virtual const void *direct_access(Inode *inode, off_t pos, size_t *length, int *error);
+
 	// Usually filesystems do not need to implement this!
 	// A generic implementation that uses the filesystem's get_block function is provided
 	// as default in filesystem.cc.
@@ -61,8 +72,10 @@ class Filesystem {
 	// (e.g. ext2/3/4) have "fast symlinks" where the symlink path is stored inline with
 	// the inode, so no allocations and therefore no freeing is needed. In that case just
 	// don't set the callback.
-	// The default implementation in filesystem.cc allocates a buffer with size 'inode->size + 1',
-	// uses the read function to fill the buffer and zero-terminates it.
+	// The default implementation in filesystem.cc allocates a buffer with size 'inode->size + 1'
+	// from the scratch arena (see fs/arena.h), uses the read function to fill the buffer and
+	// zero-terminates it. It sets no callback; the buffer is released by an Arena::Scope the
+	// caller has to open around the call.
 	// Symlinks must not be longer than MAX_SYMLINK_LEN (see definitions.h)
 	// Returns nullptr and sets 'error' on error.
 	virtual const char *get_link(Inode *inode, void (**cleanup_callback)(const char *buf), int *error);
@@ -1,9 +1,21 @@
 #include "fs/harddisk.h"
 
-#include "utils/alloc.h"
+#include "fs/slab.h"
 
 #include "debug/output.h"
 
+// Block buffers, one cache per supported block size (512 to 4096 bytes)
+static SlabCache buffers[] = {
+	{"Block 512", 512, 64},
+	{"Block 1024", 1024, 64},
+	{"Block 2048", 2048, 64},
+	{"Block 4096", 4096, 64},
+};
+
+static SlabCache &buffer_cache(unsigned int blocksize_bits) {
+	return buffers[blocksize_bits - 9];
+}
+
 //
 // Public
 //
@@ -11,7 +23,7 @@
 Block Harddisk::fix(uint64_t block_number) {
 	Block block(this, block_number);
 
-	void *dest_buf = malloc(blocksize);
+	void *dest_buf = buffer_cache(blocksize_bits).allocate();
 	if (dest_buf == nullptr) {
 		block.flags = -ENOMEM;
 		return block;
@@ -20,7 +32,7 @@ Block Harddisk::fix(uint64_t block_number) {
 	int retval = read_sectors(block_number, 1, dest_buf);
 	if (retval != 0) {
 		block.flags = retval;
-		free(dest_buf);
+		buffer_cache(blocksize_bits).deallocate(dest_buf);
 		return block;
 	}
 
@@ -30,14 +42,14 @@ Block Harddisk::fix(uint64_t block_number) {
 
 void Harddisk::unfix(Block *block) {
 	if(!block->is_dirty()) {
-		free(block->data);
+		buffer_cache(blocksize_bits).deallocate(block->data);
 		block->data = nullptr;
 		return;
 	}
 	// dirty → write block to disk
 
 	sync(block);  // ignore errors is intended
-	free(block->data);
+	buffer_cache(blocksize_bits).deallocate(block->data);
 	block->data = nullptr;
 }
 
@@ -7,6 +7,8 @@
 #include "fs/minix/bitutil.h"
 #include "debug/assert.h"
 
+SlabCache MinixInode::cache{"MinixInode", sizeof(MinixInode)};
+
 Inode *Minix::allocate_inode() {
 	MinixInode *inode = new MinixInode(this);
 	return static_cast<Inode *>(inode);
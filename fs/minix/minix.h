@@ -5,6 +5,7 @@
 #include "fs/filesystem.h"
 #include "fs/inode.h"
 #include "fs/block.h"
+#include "fs/slab.h"
 
 #define MINIX_ROOT_INO 1
 #define MINIX3_SUPER_MAGIC 0x4d5a
@@ -136,4 +137,16 @@ class MinixInode : public Inode {
 			write_to_disk();
 		}
 	}
+
+	// Inodes are allocated from their own cache (returns nullptr if out of memory)
+	static SlabCache cache;
+
+	static void *operator new(size_t size) noexcept {
+		(void) size;
+		return cache.allocate();
+	}
+
+	static void operator delete(void *ptr) {
+		cache.deallocate(ptr);
+	}
 };
@@ -24,6 +24,16 @@ void Ramdisk::unfix(Block *block) {
 	// noop
 }
 
+void *Ramdisk::direct_access(uint64_t block_number, uint64_t *count) {
+	uint64_t blocks = size >> blocksize_bits;
+	if (block_number >= blocks) {
+		*count = 0;
+		return nullptr;
+	}
+	*count = blocks - block_number;
+	return buf + (block_number << blocksize_bits);
+}
+
 int Ramdisk::sync() {
 	// noop
 	return 0;
@@ -13,4 +13,5 @@ class Ramdisk: public BlockDevice {
 	void unfix(Block *block);
 	int sync();
 	int sync(Block *block);
+	void *direct_access(uint64_t block_number, uint64_t *count);
 };
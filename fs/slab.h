@@ -0,0 +1,32 @@
+#pragma once
+
+// Object caches for the filesystem layer.
+// Inside the kernel these are provided by memory/slab.h; the host tool
+// (fstool) simply forwards to malloc.
+
+#ifdef FSTOOL
+
+#include "types.h"
+#include "utils/alloc.h"
+
+class SlabCache {
+	size_t size;
+
+ public:
+	SlabCache(const char *name, size_t size, size_t align = 16) : size(size) {
+		(void) name;
+		(void) align;
+	}
+
+	void *allocate() {
+		return malloc(size);
+	}
+
+	void deallocate(void *object) {
+		free(object);
+	}
+};
+
+#else
+#include "memory/slab.h"
+#endif
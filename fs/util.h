@@ -9,6 +9,17 @@ static inline size_t copy_to_user(void *to, const void *from, size_t n) {
 	return n;
 }
 
+// For large transfers, which would only displace the cached data: the
+// destination is written without being cached (the host tool just copies)
+static inline size_t copy_to_user_stream(void *to, const void *from, size_t n) {
+#ifdef FSTOOL
+	memcpy(to, from, n);
+#else
+	memcpy_stream(to, from, n);
+#endif
+	return n;
+}
+
 static inline size_t copy_from_user(void *to, const void *from, size_t n) {
 	memcpy(to, from, n);
 	return n;
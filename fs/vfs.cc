@@ -4,6 +4,7 @@
 #include "fs/minix/minix.h"
 #include "fs/dir_context.h"
 #include "fs/util.h"
+#include "fs/arena.h"
 #include "utils/alloc.h"
 #include "utils/string.h"
 #include "debug/output.h"
@@ -17,6 +18,11 @@ Filesystem *VFS::root_fs = nullptr;
 Inode *VFS::global_cwd = nullptr;
 FD_Table VFS::fd_table;
 
+SlabCache File::cache{"File", sizeof(File)};
+
+// Directory streams of opendir()
+static SlabCache dir_cache{"DIR", sizeof(DIR)};
+
 struct path {
 	Inode *cur_dir;
 	const char *pathname;
@@ -270,6 +276,45 @@ ssize_t VFS::read(int fd, void *buf, size_t count) {
 	return bytes_read;
 }
 
+ssize_t VFS::map(int fd, off_t offset, size_t length, const void **addr) {
+	// @Synchronization
+	if (addr == nullptr || offset < 0) {
+		return -EINVAL;
+	}
+
+	if (length > SSIZE_MAX) {
+		length = SSIZE_MAX;
+	}
+
+	File *file = fd_table.get_file(fd);
+	if (file == nullptr) {
+		return -EBADF;
+	}
+
+	if ((file->accmode & O_WRONLY) != 0) {
+		return -EBADF;
+	}
+
+	Inode *inode = file->inode;
+	if (!S_ISREG(inode->mode)) {
+		return -EISDIR;
+	}
+
+	if (length == 0 || offset >= inode->size) {
+		*addr = nullptr;
+		return 0;
+	}
+
+	Filesystem *fs = inode->filesystem;
+	int error = 0;
+	const void *direct = fs->direct_access(inode, offset, &length, &error);
+	if (direct == nullptr) {
+		return error != 0 ? error : -EOPNOTSUPP;
+	}
+	*addr = direct;
+	return length;
+}
+
 ssize_t VFS::write(int fd, const void *buf, size_t count) {
 	// @Synchronization
 	if ((buf == nullptr) || count == 0) {
@@ -451,7 +496,7 @@ DIR * VFS::opendir(const char *name) {
 		int fd = open(name, O_RDONLY);
 		lseek(fd, 0, SEEK_SET);
 		if (fd >= 0) {
-			DIR *dirp = reinterpret_cast<DIR *>(calloc(1, sizeof(DIR)));
+			DIR *dirp = reinterpret_cast<DIR *>(dir_cache.allocate());
 			if (dirp == nullptr) {
 				close(fd);
 			} else {
@@ -492,7 +537,7 @@ void VFS::rewinddir(DIR *dirp) {
 int VFS::closedir(DIR *dirp) {
 	if (dirp != 0) {
 		int r = close(dirp->fd);
-		free(dirp);
+		dir_cache.deallocate(dirp);
 		return r;
 	} else {
 		return 0;
@@ -615,6 +660,7 @@ ssize_t VFS::readlink(const char *pathname, char *buf, size_t bufsiz) {
 		inode->put();
 		return -EINVAL;
 	}
+	Arena::Scope scope(Arena::scratch());
 	void (*cleanup_callback)(const char *buf) = nullptr;
 	Filesystem *fs = inode->filesystem;
 	const char *link_path = fs->get_link(inode, &cleanup_callback, &error);
@@ -1040,6 +1086,7 @@ Inode *VFS::resolve_symlink(Inode *symlink, Inode *cur_dir, int depth, int *erro
 		return nullptr;
 	}
 	Filesystem *fs = symlink->filesystem;
+	Arena::Scope scope(Arena::scratch());
 	void (*cleanup_callback)(const char *buf) = nullptr;
 	const char *link_path = fs->get_link(symlink, &cleanup_callback, error);
 	if (link_path == nullptr) {
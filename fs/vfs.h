@@ -66,6 +66,20 @@ class VFS {
 	 *  \p count. Siehe man 2 read. */
 	static ssize_t read(int fd, void *buf, size_t count);
 
+	/*! \brief Direkter Zugriff auf den Inhalt der Datei \p fd ab \p offset, ohne ihn zu kopieren.
+	 *
+	 *  Nur möglich, falls das Blockgerät seinen Speicher direkt bereitstellt (z.B. eine Ramdisk).
+	 *  In \p addr wird die Adresse des Inhalts an Position \p offset abgelegt.
+	 *  Die Dateiposition wird nicht verändert.
+	 *
+	 *  \return Anzahl der zusammenhängend abgebildeten Bytes (höchstens \p length, 0 am
+	 *  Dateiende) oder ein negativer Fehlercode (-EOPNOTSUPP ohne direkten Zugriff).
+	 *
+	 *  Der Speicher darf nur gelesen werden und ist nur gültig, solange das Dateisystem
+	 *  eingehängt ist und die Datei nicht verändert wird.
+	 */
+	static ssize_t map(int fd, off_t offset, size_t length, const void **addr);
+
 	/*! \brief Schreiben von Daten aus Speicher \p buf der Länge
 	 *  \p count an Dateideskriptor \p fd. Siehe man 2 write */
 	static ssize_t write(int fd, const void *buf, size_t count);
@@ -19,12 +19,42 @@ class Gate {
 	Gate& operator=(const Gate&) = delete;
 
  public:
+	/*! \brief Successor in the \ref GateQueue of each core
+	 */
 	Gate* next[Core::MAX];
 
+	/*! \brief Whether the gate is in the \ref GateQueue of each core
+	 *  (for O(1) duplicate suppression)
+	 */
+	volatile bool queued[Core::MAX];
+
+	/*! \brief Execute the epilogue in an \ref IRQThread instead of
+	 *  \ref Guard::leave
+	 */
+	bool threaded;
+
+#ifdef IRQLATENCY
+	/*! \brief Time stamp of the prologue end of the pending epilogue on each
+	 *  core (see \ref IRQLatency)
+	 */
+	uint64_t raised[Core::MAX];
+
+	/*! \brief Vector of the pending epilogue on each core
+	 */
+	unsigned vector[Core::MAX];
+#endif
+
 	/*! \brief Constructor
 	 */
-	Gate() {
-		for (uint32_t i = 0; i < Core::MAX; i++) next[i] = nullptr;
+	Gate() : threaded(false) {
+		for (uint32_t i = 0; i < Core::MAX; i++) {
+			next[i] = nullptr;
+			queued[i] = false;
+#ifdef IRQLATENCY
+			raised[i] = 0;
+			vector[i] = 0;
+#endif
+		}
 	}
 
 	/*! \brief Destructor
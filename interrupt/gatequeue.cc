@@ -2,31 +2,42 @@
 #include "machine/core.h"
 
 GateQueue gatequeue{};
-Gate* head[Core::MAX];
 
-bool GateQueue::enqueue(Gate* item)  {
-    if (head[Core::getID()] == nullptr) {
-        head[Core::getID()] = item;
-        return true;
-    }
-    Gate* current = head[Core::getID()];
-    while (current->next[Core::getID()] != nullptr) {
-        if (current == item) {
-            return false;
-        }
-        current = current->next[Core::getID()];
-    }
-    current->next[Core::getID()] = item;
+bool GateQueue::enqueue(Gate* item) {
+    unsigned core = Core::getID();
+    if (item->queued[core])
+        return false;
+    item->queued[core] = true;
+    item->next[core] = nullptr;
+
+    Gate** tail = local[core].tail;
+    __atomic_store_n(&local[core].tail, &item->next[core], __ATOMIC_RELAXED);
+    __atomic_store_n(tail, item, __ATOMIC_RELAXED);
     return true;
 }
 
 Gate* GateQueue::dequeue() {
-    Gate* current = head[Core::getID()];
-    if (current == nullptr) {
-        return current;
+    unsigned core = Core::getID();
+    Gate* item = __atomic_load_n(&local[core].head, __ATOMIC_RELAXED);
+    if (item == nullptr)
+        return nullptr;
+
+    Gate* next = __atomic_load_n(&item->next[core], __ATOMIC_RELAXED);
+    if (next == nullptr) {
+        // item seems to be the last element: reset the queue, unless a
+        // prologue appends a new gate (to item->next) in the meantime
+        __atomic_store_n(&local[core].head, nullptr, __ATOMIC_RELAXED);
+        Gate** expected = &item->next[core];
+        if (!__atomic_compare_exchange_n(&local[core].tail, &expected, &local[core].head,
+                                         false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            __atomic_store_n(&local[core].head, __atomic_load_n(&item->next[core], __ATOMIC_RELAXED),
+                             __ATOMIC_RELAXED);
+        }
+    } else {
+        __atomic_store_n(&local[core].head, next, __ATOMIC_RELAXED);
     }
-    Gate* item = current;
-    item->next[Core::getID()] = nullptr;
-    head[Core::getID()] = current->next[Core::getID()];
+
+    // from now on, the gate may be enqueued again
+    __atomic_store_n(&item->queued[core], false, __ATOMIC_RELEASE);
     return item;
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "interrupt/gate.h"
+#include "machine/cache.h"
 
 /*! \brief Queue for \ref Gate "Gates"
  *
@@ -14,9 +15,37 @@
  * \ref Gate item on each \ref Core (up to \ref Core::MAX) at the same time
  * (a multi-queue, requiring a `head` pointer array member in this class and
  * a `next` pointer array in \ref Gate).
+ *
+ * Each core has its own queue with a head and a tail pointer (the latter
+ * pointing to the last element's `next` pointer, like in \ref Queue), and
+ * every \ref Gate carries a `queued` flag per core -- hence both operations
+ * are O(1).
+ * \ref enqueue is only called by prologues (i.e. with interrupts disabled),
+ * while \ref dequeue may be interrupted by them at any point: it only
+ * updates the tail pointer with an atomic compare-and-swap, so interrupts do
+ * not have to be disabled.
  */
 class GateQueue {
+	// Prevent copies and assignments
+	GateQueue(const GateQueue&)            = delete;
+	GateQueue& operator=(const GateQueue&) = delete;
+
+	/// Core local queue (cache aligned to prevent false sharing)
+	struct cache_aligned {
+		Gate* head;
+		Gate** tail;
+	} local[Core::MAX];
+
  public:
+	/*! \brief Constructor; initializes all queues as empty
+	 */
+	GateQueue() {
+		for (unsigned i = 0; i < Core::MAX; i++) {
+			local[i].head = nullptr;
+			local[i].tail = &local[i].head;
+		}
+	}
+
 	/*! \brief Enqueues the provided item at the end of the queue.
 	 *
 	 * In \MPStuBS the item is added to the internal queue belonging to the core
@@ -1,40 +1,69 @@
 #include "interrupt/guard.h"
 #include "interrupt/gatequeue.h"
+#include "interrupt/irqlatency.h"
+#include "interrupt/remotecall.h"
+#include "machine/cache.h"
 #include "machine/core.h"
+#include "machine/tsc.h"
 #include "sync/ticketlock.h"
+#include "thread/irqthread.h"
 
-bool locked[Core::MAX];
-Ticketlock BKL{};
+// per-core lock variable (cache aligned to prevent false sharing)
+static struct cache_aligned {
+    bool locked;
+} local[Core::MAX];
+Ticketlock BKL{"Guard"};
 
 void Guard::enter() {
     bool wasEnabled = Core::Interrupt::disable();
-    locked[Core::getID()] = true;
+    local[Core::getID()].locked = true;
     Core::Interrupt::restore(wasEnabled);
-    BKL.lock();
+    // Spinning with interrupts disabled (coming from relay), the REMOTE_CALL
+    // prologue can not run -- but the holder of the Guard might wait for it
+    // (e.g. for a TLB shootdown), so serve the pending calls while waiting.
+    void (*waiting)() = wasEnabled ? nullptr : RemoteCall::poll;
+#ifdef LOCKSTAT
+    // account the waiting time to the caller of the Guard
+    BKL.lock(__builtin_return_address(0), waiting);
+#else
+    BKL.lock(waiting);
+#endif
 }
 
 void Guard::leave() {
     bool wasEnabled = Core::Interrupt::disable();
-    for (Gate* item = gatequeue.dequeue(); item != nullptr; item = gatequeue.dequeue()) {
+    Gate* item = gatequeue.dequeue();
+    while (item != nullptr) {
+#ifdef IRQLATENCY
+        unsigned id = Core::getID();
+        unsigned vector = item->vector[id];
+        uint64_t start = TSC::read();
+        IRQLatency::record(IRQLatency::WAIT, vector, start - item->raised[id]);
+#endif
         Core::Interrupt::enable();
-        item->epilogue();
+        if (!item->threaded || !IRQThread::handover(item))
+            item->epilogue();
+#ifdef IRQLATENCY
         Core::Interrupt::disable();
+        IRQLatency::record(IRQLatency::EPILOGUE, vector, TSC::read() - start);
+#endif
+        item = gatequeue.dequeue();
+        if (item == nullptr) {
+            // check again with interrupts disabled, otherwise an epilogue
+            // enqueued right now would be stuck until the next leave()
+            Core::Interrupt::disable();
+            item = gatequeue.dequeue();
+        }
     }
-    locked[Core::getID()] = false;
+    local[Core::getID()].locked = false;
     BKL.unlock();
     Core::Interrupt::restore(wasEnabled);
 }
 
 void Guard::relay(Gate* item) {
-    if (!gatequeue.enqueue(item))
-        return;
-    bool wasEnabled = Core::Interrupt::disable();
-    if (!locked[Core::getID()]) {
-        Core::Interrupt::restore(wasEnabled);
+    // called by the interrupt handler, hence interrupts are already disabled
+    if (gatequeue.enqueue(item) && !local[Core::getID()].locked) {
         enter();
-        Core::Interrupt::disable();
         leave();
-    } else {
-        Core::Interrupt::restore(wasEnabled);
     }
 }
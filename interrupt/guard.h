@@ -70,6 +70,8 @@ namespace Guard {
 	/*! \brief Leaving the critical section.
 	 *
 	 * Leaves the critical section and processes all remaining (enqueued) epilogues.
+	 * Epilogues of gates marked as `threaded` are handed over to the
+	 * \ref IRQThread of the current core instead.
 	 *
 	 *  \todo Implement Method
 	 */
@@ -1,18 +1,35 @@
 #include "interrupt/handler.h"
 #include "debug/output.h"
 #include "interrupt/guard.h"
+#include "interrupt/irqlatency.h"
+#include "interrupt/irqstat.h"
 #include "interrupt/plugbox.h"
 #include "machine/core.h"
 #include "machine/lapic.h"
+#include "machine/tsc.h"
 
 extern "C" void interrupt_handler(Core::Interrupt::Vector vector, InterruptContext* context) {
+#ifdef IRQLATENCY
+	uint64_t entry = TSC::read();
+#endif
 	if (vector < Core::Interrupt::EXCEPTIONS) {
 		DBG << "ip: " << context->ip << endl;
 		DBG << "vector: " << vector << endl;
 	}
+	IRQStat::count(vector);
 	Gate* item = Plugbox::report(vector);
 	bool execute_epilogue = item->prologue();
 	LAPIC::endOfInterrupt();
+#ifdef IRQLATENCY
+	uint64_t end = TSC::read();
+	IRQLatency::record(IRQLatency::PROLOGUE, vector, end - entry);
+	unsigned id = Core::getID();
+	// keep the time stamp of an epilogue which is already pending
+	if (execute_epilogue && !item->queued[id]) {
+		item->raised[id] = end;
+		item->vector[id] = vector;
+	}
+#endif
 	if(execute_epilogue)
 		Guard::relay(item);
 }
@@ -0,0 +1,72 @@
+#include "interrupt/irqbalancer.h"
+#include "interrupt/irqstat.h"
+#include "machine/apic.h"
+#include "machine/core.h"
+#include "machine/ioapic.h"
+
+namespace IRQBalancer {
+
+// I/O APIC slots supported by the balancer
+static const uint8_t SLOTS = 24;
+
+// Interrupt count of each slot at the end of the previous period
+static uint64_t last[SLOTS];
+
+// Elapsed time of the current period in microseconds
+static uint64_t elapsed = 0;
+
+void balance() {
+    uint8_t slots = IOAPIC::slots() < SLOTS ? IOAPIC::slots() : SLOTS;
+
+    // determine the load of the active lines, sorted in descending order
+    struct {
+        uint8_t slot;
+        uint64_t load;
+    } line[SLOTS];
+    unsigned n = 0;
+    for (uint8_t slot = 0; slot < slots; slot++) {
+        if (!IOAPIC::status(slot))
+            continue;
+        uint64_t count = IRQStat::total(IOAPIC::getVector(slot));
+        uint64_t load = count - last[slot];
+        last[slot] = count;
+        if (load == 0)
+            continue;
+        unsigned i = n++;
+        for (; i > 0 && line[i - 1].load < load; i--)
+            line[i] = line[i - 1];
+        line[i].slot = slot;
+        line[i].load = load;
+    }
+
+    // assign each line to the least loaded core -- on ties, the bootstrap
+    // processor (core 0) comes last and the current destination first
+    uint64_t assigned[Core::MAX] = {};
+    for (unsigned i = 0; i < n; i++) {
+        uint8_t destination = IOAPIC::getDestination(line[i].slot);
+        unsigned target = Core::MAX;
+        for (unsigned core = 0; core < Core::MAX; core++) {
+            if (!Core::isOnline(core))
+                continue;
+            if (target == Core::MAX || assigned[core] < assigned[target] ||
+                (assigned[core] == assigned[target] &&
+                 (target == 0 || APIC::getLogicalAPICID(core) == destination)))
+                target = core;
+        }
+        if (target == Core::MAX)
+            return;
+        assigned[target] += line[i].load;
+        if (destination != APIC::getLogicalAPICID(target))
+            IOAPIC::setAffinity(line[i].slot, target);
+    }
+}
+
+void tick(uint32_t interval) {
+    elapsed += interval;
+    if (elapsed >= PERIOD * 1000ULL) {
+        elapsed = 0;
+        balance();
+    }
+}
+
+}  // namespace IRQBalancer
@@ -0,0 +1,41 @@
+/*! \file
+ *  \brief \ref IRQBalancer distributes external interrupts among the cores
+ */
+
+#pragma once
+
+#include "types.h"
+
+/*! \brief Spreads busy \ref IOAPIC lines across the online cores
+ *  \ingroup interrupts
+ *
+ *  Periodically, the number of interrupts of each unmasked I/O APIC slot
+ *  during the last period is determined using the \ref IRQStat counters.
+ *  The lines are then (greedily, busiest first) bound via
+ *  \ref IOAPIC::setAffinity to the core with the least load assigned so far.
+ *  On ties, a line stays at its current core, and the bootstrap processor
+ *  (core 0) is taken last.
+ *  Lines without interrupts in the last period keep their routing.
+ */
+namespace IRQBalancer {
+
+/*! \brief Length of a balancing period in milliseconds
+ */
+const unsigned PERIOD = 1000;
+
+/*! \brief Redistribute the interrupt lines based on the load since the last
+ *  call
+ *
+ *  \note Has to be called on epilogue level
+ */
+void balance();
+
+/*! \brief Call \ref balance once per \ref PERIOD
+ *
+ *  Called by the \ref Watch epilogue on core 0.
+ *
+ *  \param interval Timer interval in microseconds
+ */
+void tick(uint32_t interval);
+
+}  // namespace IRQBalancer
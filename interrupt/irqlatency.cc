@@ -0,0 +1,45 @@
+#include "interrupt/irqlatency.h"
+
+#ifdef IRQLATENCY
+
+#include "object/outputstream.h"
+
+namespace IRQLatency {
+
+Histograms histograms[Core::MAX]{};
+
+static const char *name[PHASES] = {"prologue", "wait", "epilogue"};
+
+void report(OutputStream &out) {
+    out << "vector phase core: log2(cycles):count ..." << endl;
+    for (unsigned v = 0; v < Core::Interrupt::VECTORS - Core::Interrupt::EXCEPTIONS; v++) {
+        for (unsigned phase = 0; phase < PHASES; phase++) {
+            for (unsigned core = 0; core < Core::MAX; core++) {
+                const uint32_t *bucket = histograms[core].bucket[v][phase];
+                bool empty = true;
+                for (unsigned b = 0; b < BUCKETS; b++) {
+                    if (bucket[b] != 0) {
+                        if (empty)
+                            out << (v + Core::Interrupt::EXCEPTIONS) << " " << name[phase] << " " << core << ":";
+                        empty = false;
+                        out << " " << b << ":" << bucket[b];
+                    }
+                }
+                if (!empty)
+                    out << endl;
+            }
+        }
+    }
+}
+
+void reset() {
+    for (unsigned core = 0; core < Core::MAX; core++)
+        for (unsigned v = 0; v < Core::Interrupt::VECTORS - Core::Interrupt::EXCEPTIONS; v++)
+            for (unsigned phase = 0; phase < PHASES; phase++)
+                for (unsigned b = 0; b < BUCKETS; b++)
+                    histograms[core].bucket[v][phase][b] = 0;
+}
+
+}  // namespace IRQLatency
+
+#endif
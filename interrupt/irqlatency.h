@@ -0,0 +1,85 @@
+/*! \file
+ *  \brief \ref IRQLatency "Interrupt latency histograms"
+ */
+
+#pragma once
+
+#include "types.h"
+#include "machine/cache.h"
+#include "machine/core.h"
+
+class OutputStream;
+
+/*! \brief Per-core, per-vector histograms of interrupt handling times
+ *  \ingroup interrupts
+ *
+ *  Only available if the kernel is compiled with `-DIRQLATENCY`.
+ *
+ *  Time stamps (TSC cycles) are taken at the entry of \ref interrupt_handler,
+ *  at the end of the prologue and at the begin and end of the epilogue in
+ *  \ref Guard::leave. From these, three phases are accounted:
+ *   - \ref PROLOGUE: interrupt entry until the prologue returned
+ *   - \ref WAIT: prologue end until the epilogue starts (time spent in the
+ *     \ref GateQueue, e.g. while another core holds the \ref Guard)
+ *   - \ref EPILOGUE: execution of the epilogue (for threaded gates only
+ *     the handover to the \ref IRQThread; for epilogues switching threads,
+ *     like the \ref Watch, including the time until the interrupted thread
+ *     continues)
+ *
+ *  Each phase is recorded in a histogram with logarithmic (base 2) buckets:
+ *  bucket `i` counts durations in `[2^i, 2^(i+1))` cycles, the last bucket
+ *  everything above. The histograms can be printed with \ref report -- e.g.
+ *  to a \ref SerialStream or via the `monitor latency` command of the
+ *  \ref GDB_Stub.
+ */
+#ifdef IRQLATENCY
+namespace IRQLatency {
+
+/*! \brief Measured phases of interrupt handling
+ */
+enum Phase {
+	PROLOGUE,
+	WAIT,
+	EPILOGUE,
+	PHASES
+};
+
+/// Number of histogram buckets
+const unsigned BUCKETS = 32;
+
+/*! \brief Histograms of a single core (for all non-exception vectors)
+ */
+struct cache_aligned Histograms {
+	uint32_t bucket[Core::Interrupt::VECTORS - Core::Interrupt::EXCEPTIONS][PHASES][BUCKETS];
+};
+
+extern Histograms histograms[Core::MAX];
+
+/*! \brief Account a duration on the current core
+ *  \note Has to be called with interrupts disabled
+ *  \param phase Measured phase
+ *  \param vector Interrupt vector
+ *  \param cycles Duration in TSC cycles
+ */
+inline void record(Phase phase, unsigned vector, uint64_t cycles) {
+	if (vector < Core::Interrupt::EXCEPTIONS) {
+		return;
+	}
+	unsigned bucket = cycles == 0 ? 0 : 63 - __builtin_clzll(cycles);
+	if (bucket >= BUCKETS) {
+		bucket = BUCKETS - 1;
+	}
+	histograms[Core::getID()].bucket[vector - Core::Interrupt::EXCEPTIONS][phase][bucket]++;
+}
+
+/*! \brief Print the non-empty histograms of all online cores
+ *  \param out Output stream
+ */
+void report(OutputStream &out);
+
+/*! \brief Clear all histograms
+ */
+void reset();
+
+}  // namespace IRQLatency
+#endif
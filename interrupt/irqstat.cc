@@ -0,0 +1,73 @@
+#include "interrupt/irqstat.h"
+#include "machine/tsc.h"
+#include "object/outputstream.h"
+#include "thread/irqthread.h"
+
+namespace IRQStat {
+
+Counters counters[Core::MAX]{};
+
+uint64_t total(Core::Interrupt::Vector vector) {
+    uint64_t sum = 0;
+    for (unsigned core = 0; core < Core::MAX; core++)
+        sum += counters[core].vector[vector];
+    return sum;
+}
+
+static const char *name(unsigned vector) {
+    switch (vector) {
+        case Core::Interrupt::TIMER:       return "timer";
+        case Core::Interrupt::KEYBOARD:    return "keyboard";
+        case Core::Interrupt::PANIC:       return "panic";
+        case Core::Interrupt::GDB:         return "gdb";
+        case Core::Interrupt::ASSASSIN:    return "assassin";
+        case Core::Interrupt::WAKEUP:      return "wakeup";
+        case Core::Interrupt::REMOTE_CALL: return "remote call";
+        default:                           return vector < Core::Interrupt::EXCEPTIONS ? "exception" : "";
+    }
+}
+
+void report(OutputStream &out) {
+    out << "vector:";
+    for (unsigned core = 0; core < Core::MAX; core++) {
+        if (Core::isOnline(core))
+            out << "\tCPU" << core;
+    }
+    out << endl;
+    for (unsigned vector = 0; vector < Core::Interrupt::VECTORS; vector++) {
+        Core::Interrupt::Vector v = static_cast<Core::Interrupt::Vector>(vector);
+        if (total(v) == 0)
+            continue;
+        out << vector << ":";
+        for (unsigned core = 0; core < Core::MAX; core++) {
+            if (Core::isOnline(core))
+                out << "\t" << get(core, v);
+        }
+        out << "\t" << name(vector) << endl;
+    }
+
+    // latency of the epilogues handed over to the interrupt threads
+    bool threaded = false;
+    for (unsigned core = 0; core < Core::MAX; core++)
+        threaded |= irqthread[core].count() != 0;
+    if (!threaded)
+        return;
+    out << "threaded:";
+    for (unsigned core = 0; core < Core::MAX; core++) {
+        if (Core::isOnline(core))
+            out << "\t" << irqthread[core].count();
+    }
+    out << "\tepilogues" << endl << "avg us:";
+    for (unsigned core = 0; core < Core::MAX; core++) {
+        if (Core::isOnline(core))
+            out << "\t" << TSC::nanoseconds(irqthread[core].averageLatency()) / 1000;
+    }
+    out << "\thandover latency" << endl << "max us:";
+    for (unsigned core = 0; core < Core::MAX; core++) {
+        if (Core::isOnline(core))
+            out << "\t" << TSC::nanoseconds(irqthread[core].maxLatency()) / 1000;
+    }
+    out << "\thandover latency" << endl;
+}
+
+}  // namespace IRQStat
@@ -0,0 +1,61 @@
+/*! \file
+ *  \brief \ref IRQStat counts interrupts per core and vector
+ */
+
+#pragma once
+
+#include "types.h"
+#include "machine/cache.h"
+#include "machine/core.h"
+
+class OutputStream;
+
+/*! \brief Per-core interrupt counters (similar to Linux' `/proc/interrupts`)
+ *  \ingroup interrupts
+ *
+ *  Every interrupt is counted by \ref interrupt_handler() on the core
+ *  handling it. As each core only writes its own (cache aligned) counters,
+ *  no synchronization is required; readers might see slightly outdated values.
+ */
+namespace IRQStat {
+
+/*! \brief Interrupt counters of a single core
+ */
+struct cache_aligned Counters {
+	/// Number of interrupts for each vector
+	uint64_t vector[Core::Interrupt::VECTORS];
+};
+
+extern Counters counters[Core::MAX];
+
+/*! \brief Account an interrupt on the current core
+ *  \note Has to be called with interrupts disabled
+ *  \param vector Interrupt vector
+ */
+inline void count(Core::Interrupt::Vector vector) {
+	counters[Core::getID()].vector[vector]++;
+}
+
+/*! \brief Number of interrupts handled by a core
+ *  \param core ID of the core
+ *  \param vector Interrupt vector
+ */
+inline uint64_t get(unsigned core, Core::Interrupt::Vector vector) {
+	return counters[core].vector[vector];
+}
+
+/*! \brief Number of interrupts handled by all cores
+ *  \param vector Interrupt vector
+ */
+uint64_t total(Core::Interrupt::Vector vector);
+
+/*! \brief Print a table of all vectors which occurred, with one column per
+ *  online core
+ *
+ *  If epilogues were handed over to an \ref IRQThread, their number and the
+ *  average and maximum handover latency of each core's thread follow.
+ *  \param out Output stream
+ */
+void report(OutputStream &out);
+
+}  // namespace IRQStat
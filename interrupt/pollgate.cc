@@ -0,0 +1,20 @@
+#include "interrupt/pollgate.h"
+#include "interrupt/plugbox.h"
+#include "machine/ioapic.h"
+#include "thread/pollthread.h"
+
+void PollGate::attach(Core::Interrupt::Vector vector, uint8_t slot, IOAPIC::TriggerMode trigger_mode) {
+    this->slot = slot;
+    Plugbox::assign(vector, this);
+    IOAPIC::config(slot, vector, trigger_mode);
+    IOAPIC::allow(slot);
+}
+
+bool PollGate::prologue() {
+    IOAPIC::forbid(slot);
+    return true;
+}
+
+void PollGate::epilogue() {
+    PollThread::schedule(this);
+}
@@ -0,0 +1,74 @@
+/*! \file
+ *  \brief \ref PollGate for devices switching between interrupts and polling
+ */
+
+#pragma once
+
+#include "interrupt/gate.h"
+#include "machine/ioapic_registers.h"
+#include "object/queue.h"
+
+/*! \brief Device with interrupt coalescing (similar to Linux' NAPI)
+ *  \ingroup interrupts
+ *
+ * Instead of handling each received item in its own interrupt, the prologue
+ * merely masks the device's \ref IOAPIC line and the epilogue schedules the
+ * \ref PollThread. The latter drains the device in batches of at most
+ * \ref PollThread::BUDGET items by calling \ref poll. As soon as a batch
+ * comes up short, the device is considered drained and its line unmasked
+ * again.
+ *
+ * Under low load, this behaves like a normal interrupt-driven device. Under
+ * high load, the device is serviced by polling without taking an interrupt
+ * per item.
+ *
+ * \note The line should be \ref IOAPIC::LEVEL "level triggered" -- otherwise
+ *       an item arriving between the last poll and unmasking the line would
+ *       go unnoticed.
+ */
+class PollGate : public Gate, public Queue<PollGate>::Node {
+	// Prevent copies and assignments
+	PollGate(const PollGate&)            = delete;
+	PollGate& operator=(const PollGate&) = delete;
+
+	friend class PollThread;
+
+	/// I/O APIC slot of the device
+	uint8_t slot;
+
+	/// Device is masked and waiting for (or being serviced by) the \ref PollThread
+	bool scheduled;
+
+ protected:
+	/*! \brief Register the device at the \ref Plugbox and \ref IOAPIC and
+	 *  unmask its line
+	 *
+	 * \param vector Interrupt vector for the device
+	 * \param slot I/O APIC slot of the device
+	 * \param trigger_mode Trigger mode of the line
+	 */
+	void attach(Core::Interrupt::Vector vector, uint8_t slot, IOAPIC::TriggerMode trigger_mode = IOAPIC::LEVEL);
+
+ public:
+	/*! \brief Constructor
+	 */
+	PollGate() : slot(0), scheduled(false) {}
+
+	/*! \brief Mask the line of the device
+	 *
+	 * \return `true` (the epilogue schedules the \ref PollThread)
+	 */
+	bool prologue() override;
+
+	/*! \brief Schedule the \ref PollThread to service this device
+	 */
+	void epilogue() override;
+
+	/*! \brief Service the device (on epilogue level)
+	 *
+	 * \param budget Maximum number of items to handle
+	 * \return Number of handled items -- less than `budget` if the device
+	 *         has been drained
+	 */
+	virtual unsigned poll(unsigned budget) = 0;
+};
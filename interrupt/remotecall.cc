@@ -0,0 +1,112 @@
+#include "interrupt/remotecall.h"
+#include "interrupt/plugbox.h"
+#include "machine/apic.h"
+#include "machine/cache.h"
+#include "machine/lapic.h"
+#include "debug/assert.h"
+
+RemoteCall remotecall{};
+
+// Pending calls of each core (Treiber stack, newest first)
+static struct cache_aligned {
+    RemoteCall::Call *volatile head;
+} queue[Core::MAX];
+
+void RemoteCall::activate() {
+    Plugbox::assign(Core::Interrupt::Vector::REMOTE_CALL, this);
+}
+
+bool RemoteCall::prologue() {
+    poll();
+    return false;
+}
+
+void RemoteCall::poll() {
+    Call *call = __atomic_exchange_n(&queue[Core::getID()].head, nullptr, __ATOMIC_ACQUIRE);
+
+    // reverse to execute the calls in the order they were issued
+    Call *ordered = nullptr;
+    while (call != nullptr) {
+        Call *next = call->next;
+        call->next = ordered;
+        ordered = call;
+        call = next;
+    }
+
+    while (ordered != nullptr) {
+        // the caller may reuse the call as soon as it is done
+        Call *next = ordered->next;
+        ordered->func(ordered->arg);
+        __atomic_store_n(&ordered->done, true, __ATOMIC_RELEASE);
+        ordered = next;
+    }
+}
+
+bool RemoteCall::enqueue(unsigned core, Call *call) {
+    call->done = false;
+    Call *head = __atomic_load_n(&queue[core].head, __ATOMIC_RELAXED);
+    do {
+        call->next = head;
+    } while (!__atomic_compare_exchange_n(&queue[core].head, &head, call, true,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    return head == nullptr;
+}
+
+void RemoteCall::callOn(unsigned core, Call *call) {
+    assert(call != nullptr && call->isDone());
+    assert(core < Core::MAX && Core::isOnline(core));
+    bool enabled = Core::Interrupt::disable();
+    if (core == Core::getID()) {
+        call->func(call->arg);
+    } else if (enqueue(core, call)) {
+        LAPIC::IPI::send(APIC::getLAPICID(core), Core::Interrupt::REMOTE_CALL);
+    }
+    Core::Interrupt::restore(enabled);
+}
+
+void RemoteCall::callOn(unsigned core, void (*func)(void *arg), void *arg) {
+    Call call(func, arg);
+    bool enabled = Core::Interrupt::disable();
+    callOn(core, &call);
+    while (!call.isDone()) {
+        poll();
+        Core::pause();
+    }
+    Core::Interrupt::restore(enabled);
+}
+
+void RemoteCall::callOnAll(Call *calls) {
+    assert(calls != nullptr);
+    bool enabled = Core::Interrupt::disable();
+    unsigned id = Core::getID();
+    uint8_t destination = 0;
+    for (unsigned core = 0; core < Core::MAX; core++) {
+        if (core == id || !Core::isOnline(core))
+            continue;
+        assert(calls[core].isDone());
+        if (enqueue(core, &calls[core]))
+            destination |= APIC::getLogicalAPICID(core);
+    }
+    // a single IPI for all cores whose queue was empty
+    if (destination != 0)
+        LAPIC::IPI::sendGroup(destination, Core::Interrupt::REMOTE_CALL);
+    calls[id].func(calls[id].arg);
+    Core::Interrupt::restore(enabled);
+}
+
+void RemoteCall::callOnAll(void (*func)(void *arg), void *arg) {
+    Call calls[Core::MAX];
+    for (unsigned core = 0; core < Core::MAX; core++) {
+        calls[core].func = func;
+        calls[core].arg = arg;
+    }
+    bool enabled = Core::Interrupt::disable();
+    callOnAll(calls);
+    for (unsigned core = 0; core < Core::MAX; core++) {
+        while (!calls[core].isDone()) {
+            poll();
+            Core::pause();
+        }
+    }
+    Core::Interrupt::restore(enabled);
+}
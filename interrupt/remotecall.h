@@ -0,0 +1,123 @@
+/*! \file
+ *  \brief \ref RemoteCall executes functions on other cores
+ */
+
+#pragma once
+
+#include "interrupt/gate.h"
+
+/*! \brief Execute functions on other CPU cores
+ *  \ingroup interrupts
+ *
+ *  Generic cross-core primitive (e.g., for TLB shootdowns or arming remote
+ *  timers) using a single IPI vector: Each core has a lock-free (multiple
+ *  producer, single consumer) queue of pending \ref Call "calls", which is
+ *  drained by the prologue of the \ref Core::Interrupt::REMOTE_CALL IPI.
+ *  An IPI is only sent if the queue of the target was empty before -- several
+ *  calls issued in quick succession are hence batched behind one interrupt.
+ *
+ *  The functions are executed on interrupt level (with interrupts disabled)
+ *  and therefore must be short and may not enter the \ref Guard.
+ *
+ *  Synchronous calls spin until the function has been executed on the target
+ *  core. While spinning, they execute calls to the current core themselves,
+ *  preventing a deadlock of two cores calling each other.
+ *
+ *  Only required for \MPStuBS.
+ */
+class RemoteCall : public Gate {
+	// Prevent copies and assignments
+	RemoteCall(const RemoteCall&)            = delete;
+	RemoteCall& operator=(const RemoteCall&) = delete;
+
+ public:
+	/*! \brief Pending function call (memory provided by the caller)
+	 *
+	 *  For asynchronous calls, the object must stay valid until \ref isDone.
+	 */
+	class Call {
+		friend class RemoteCall;
+
+		Call * volatile next;
+		void (*func)(void *arg);
+		void * arg;
+		volatile bool done;
+
+	 public:
+		/*! \brief Constructor
+		 *  \param func Function to execute
+		 *  \param arg Argument passed to `func`
+		 */
+		Call(void (*func)(void *arg) = nullptr, void *arg = nullptr)
+		    : next(nullptr), func(func), arg(arg), done(true) {}
+
+		/*! \brief Check if the function has been executed (or was never issued)
+		 */
+		bool isDone() const {
+			return __atomic_load_n(&done, __ATOMIC_ACQUIRE);
+		}
+	};
+
+ private:
+	/*! \brief Enqueue a call for a remote core
+	 *  \return `true` if the queue was empty (hence an IPI is required)
+	 */
+	static bool enqueue(unsigned core, Call *call);
+
+ public:
+	RemoteCall() {}
+
+	/*! \brief Register interrupt handler.
+	 */
+	void activate();
+
+	/*! \brief Execute all calls pending for the current core
+	 *
+	 *  \return `false` (no epilogue required)
+	 */
+	bool prologue();
+
+	/*! \brief Asynchronously execute a call on a core
+	 *
+	 *  If `core` is the current core, the function is executed immediately.
+	 *
+	 *  \param core Target core (has to be online)
+	 *  \param call Call object, must not be pending
+	 */
+	static void callOn(unsigned core, Call *call);
+
+	/*! \brief Synchronously execute `func(arg)` on a core
+	 *
+	 *  Returns after the function has been executed on the target core.
+	 *
+	 *  \param core Target core (has to be online)
+	 *  \param func Function to execute
+	 *  \param arg Argument passed to `func`
+	 */
+	static void callOn(unsigned core, void (*func)(void *arg), void *arg);
+
+	/*! \brief Asynchronously execute a call on every online core
+	 *
+	 *  The function of the current core is executed immediately.
+	 *
+	 *  \param calls Array of \ref Core::MAX calls, one for each core (the
+	 *               entries of offline cores are ignored)
+	 */
+	static void callOnAll(Call *calls);
+
+	/*! \brief Synchronously execute `func(arg)` on every online core
+	 *  (including the current one)
+	 *
+	 *  \param func Function to execute
+	 *  \param arg Argument passed to `func`
+	 */
+	static void callOnAll(void (*func)(void *arg), void *arg);
+
+	/*! \brief Execute the calls pending for the current core
+	 *
+	 *  \note Has to be called with interrupts disabled
+	 */
+	static void poll();
+};
+
+extern RemoteCall remotecall;
@@ -1,6 +1,7 @@
 #include "machine/core.h"
 #include "machine/apic.h"
 #include "machine/lapic.h"
+#include "memory/paging.h"
 
 /*! \brief Initial size of CPU core stacks
  *
@@ -26,6 +27,19 @@ static unsigned core_id[255];  ///< Lookup table for CPU core IDs with LAPIC ID
 static unsigned online_cores = 0;    ///< Number of currently online CPU cores
 static bool online_core[Core::MAX];  ///< Lookup table for online CPU cores with CPU core ID as index
 
+static Local local[Core::MAX];  ///< Per-core data areas, addressed via GS base
+
+Local * getLocal(unsigned core_id) {
+	return &local[core_id];
+}
+
+void setLocal(unsigned core_id) {
+	Local * l = &local[core_id];
+	l->self = l;
+	l->id = core_id;
+	MSR<MSR_GS_BASE>::write(reinterpret_cast<uintptr_t>(l));
+}
+
 void init() {
 	// Increment number of online CPU cores
 	if (__atomic_fetch_add(&online_cores, 1, __ATOMIC_RELAXED) == 0) {
@@ -39,12 +53,19 @@ void init() {
 		}
 	}
 
-	// Get CPU ID
-	uint8_t cpu = getID();
+	// Switch to x2APIC mode (if available) before accessing the LAPIC
+	LAPIC::enable();
+
+	// Get CPU ID and set up the per-core data area
+	uint8_t cpu = core_id[LAPIC::getID()];
+	setLocal(cpu);
 
 	// initialize local APIC with logical APIC ID
 	LAPIC::init(APIC::getLogicalAPICID(cpu));
 
+	// Enable the paging features (like the no-execute bit) of this core
+	Paging::init();
+
 	// set current CPU online
 	online_core[cpu] = true;
 
@@ -56,10 +77,6 @@ void exit() {
 	__atomic_fetch_sub(&online_cores, 1, __ATOMIC_RELAXED);
 }
 
-unsigned getID() {
-	return core_id[LAPIC::getID()];
-}
-
 unsigned count() {
 	return cores;
 }
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "types.h"
+#include "machine/cache.h"
 #include "machine/core_cr.h"
 #include "machine/core_interrupt.h"
 #include "machine/core_msr.h"
@@ -21,21 +22,87 @@
  * These internals include functions to \ref Core::Interrupt "allow or deny interrupts",
  * access \ref Core::CR "control registers".
  */
+class Thread;
+
 namespace Core {
 
 /*! \brief Maximum number of supported CPUs
  */
 const unsigned MAX = 8;
 
+/*! \brief Per-core data area
+ *
+ * Each core has its own (cache line aligned) instance, whose address is stored
+ * in the core's GS segment base by \ref Core::init(). Hence, the members can
+ * be read with a single `gs:`-relative load, without knowing the core ID.
+ *
+ * \note Reloading the GS selector (`mov gs, ...` or `pop gs`) resets the base
+ *       and must be avoided once the per-core data area is set up.
+ * \see [ISDMv3, 3.4.4 Segment Loading Instructions in IA-32e Mode](intel_manual_vol3.pdf#page=94)
+ */
+struct cache_aligned Local {
+	/// Linear address of this structure (for obtaining a regular pointer)
+	Local * self;
+	/// ID of the core (a number between 0 and \ref Core::MAX)
+	unsigned id;
+	/// Life pointer of the \ref Dispatcher
+	Thread * thread;
+};
+
 /*! \brief Get the ID of the current CPU core
- * using \ref LAPIC::getID() with an internal lookup table.
+ *
+ * A single load from the \ref Local "per-core data area".
  *
  * \return ID of current Core (a number between 0 and \ref Core::MAX)
  */
-unsigned getID();
+inline unsigned getID() {
+	unsigned id;
+	asm volatile("mov %%gs:%c1, %0\n\t" : "=r"(id) : "i"(__builtin_offsetof(Local, id)));
+	return id;
+}
+
+/*! \brief Get the per-core data area of the current CPU core
+ */
+inline Local * getLocal() {
+	Local * self;
+	asm volatile("mov %%gs:%c1, %0\n\t" : "=r"(self) : "i"(__builtin_offsetof(Local, self)));
+	return self;
+}
+
+/*! \brief Get the per-core data area of an arbitrary CPU core
+ * \param core_id ID of the CPU core
+ */
+Local * getLocal(unsigned core_id);
+
+/*! \brief Get the thread stored in the per-core data area of the current core
+ */
+inline Thread * getThread() {
+	Thread * thread;
+	asm volatile("mov %%gs:%c1, %0\n\t" : "=r"(thread) : "i"(__builtin_offsetof(Local, thread)) : "memory");
+	return thread;
+}
+
+/*! \brief Store the thread in the per-core data area of the current core
+ */
+inline void setThread(Thread * thread) {
+	asm volatile("mov %0, %%gs:%c1\n\t" : : "r"(thread), "i"(__builtin_offsetof(Local, thread)) : "memory");
+}
+
+/*! \brief Point the GS segment base of the current CPU to the per-core data
+ * area of `core_id`
+ *
+ * Called by \ref Core::init(); the bootstrap processor additionally calls it
+ * first thing in \ref kernel_init() (with `0`) so that \ref getID() yields a
+ * valid ID for debug output before the \ref LAPIC is available.
+ *
+ * \param core_id ID of the CPU core
+ */
+void setLocal(unsigned core_id);
 
 /*! \brief Initialize this CPU core
  *
+ * Determine the core ID using \ref LAPIC::getID() with an internal lookup
+ * table and set up the \ref Local "per-core data area" accordingly.
  * Mark this core as *online* and setup the cores \ref LAPIC by assigning it a
  * unique \ref APIC::getLogicalAPICID() "logical APIC ID"
  *
@@ -57,8 +57,10 @@ enum Vector {
 	KEYBOARD                 = 33,    ///< Keyboard interrupt (key press / release)
 	PANIC                    = 34,    ///< Default handler for (unconfigured) interrupt events
 	GDB                      = 35,    ///< Inter-processor interrupt to stop other CPUs for debugging in \ref GDB
+	SERIAL                   = 36,    ///< Serial interface (data received)
 	ASSASSIN                 = 100,   ///< Inter-processor interrupt to immediately stop threads running on other CPUs
 	WAKEUP                   = 101,   ///< Inter-processor interrupt to WakeUp sleeping CPUs
+	REMOTE_CALL              = 102,   ///< Inter-processor interrupt to execute \ref RemoteCall "functions on other CPUs"
 
 	VECTORS                  = 256    ///< Number of interrupt vectors
 };
@@ -12,8 +12,11 @@ namespace Core {
  * \see [ISDMv4](intel_manual_vol4.pdf)
  */
 enum MSRs : uint32_t {
+	MSR_APIC_BASE     = 0x1bU,   ///< Local APIC base address and mode, \see Core::MSR_APIC_BASE
 	MSR_PLATFORM_INFO = 0xceU,   ///< Platform information including bus frequency (Intel)
+	MSR_PAT           = 0x277U,  ///< Page Attribute Table (memory types selectable in page table entries)
 	MSR_TSC_DEADLINE  = 0x6e0U,  ///< Register for \ref LAPIC::Timer Deadline mode
+	MSR_X2APIC        = 0x800U,  ///< First register of the \ref LAPIC in x2APIC mode (`0x800` -- `0x8ff`)
 	// Fast system calls
 	MSR_EFER   = 0xC0000080U,  ///< Extended Feature Enable Register, \see Core::MSR_EFER
 	MSR_STAR   = 0xC0000081U,  ///< eip (protected mode), ring 0 and 3 segment bases
@@ -42,6 +45,38 @@ enum MSR_EFER : uintptr_t {
 	MSR_EFER_TCE   = 1U << 15,  ///< Translation Cache Extension
 };
 
+/* \brief Important bits in the APIC Base Register
+ *
+ * \see [ISDMv3, 10.12.1 Detecting and Enabling x2APIC Mode](intel_manual_vol3.pdf#page=405)
+ */
+enum MSR_APIC_BASE : uintptr_t {
+	MSR_APIC_BASE_BSP  = 1U << 8,   ///< Processor is the bootstrap processor (read only)
+	MSR_APIC_BASE_EXTD = 1U << 10,  ///< x2APIC mode enable
+	MSR_APIC_BASE_EN   = 1U << 11,  ///< xAPIC global enable
+};
+
+/*! \brief Read a Model-Specific Register which is only known at runtime
+ *
+ * \param id ID of the Model-Specific Register
+ * \return Value stored in the MSR
+ * \see MSR::read()
+ */
+inline uint64_t readMSR(uint32_t id) {
+	uint32_t low, high;
+	asm volatile ("rdmsr \n\t" : "=a"(low), "=d"(high) : "c"(id));
+	return static_cast<uint64_t>(high) << 32 | low;
+}
+
+/*! \brief Write a Model-Specific Register which is only known at runtime
+ *
+ * \param id ID of the Model-Specific Register
+ * \param value Value to write into the MSR
+ * \see MSR::write()
+ */
+inline void writeMSR(uint32_t id, uint64_t value) {
+	asm volatile ("wrmsr \n\t" : : "c"(id), "a"(static_cast<uint32_t>(value)), "d"(static_cast<uint32_t>(value >> 32)));
+}
+
 /*! \brief Access to the Model-Specific Register (MSR)
  *
  * \see [ISDMv3, 9.4 Model-Specific Registers (MSRs)](intel_manual_vol3.pdf#page=319)
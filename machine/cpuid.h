@@ -29,6 +29,7 @@ enum Function : uint32_t {
 	FEATURE_BITS               = 0x1U,  ///< Feature Information (in register `ecx` and `edx`)
 	CACHE_INFORMATION          = 0x2U,  ///< Cache and TLB Information
 	PROCESSOR_SERIAL_NUMBER    = 0x3U,  ///< deprecated
+	STRUCTURED_FEATURE_BITS    = 0x7U,  ///< Structured Extended Feature Flags (subleaf 0, in register `ebx`)
 	HIGHEST_EXTENDED_FUNCTION  = 0x80000000U,  ///< Maximum Input Value for Extended Function CPUID (in register `eax`)
 	EXTENDED_PROCESSOR_INFO    = 0x80000001U,  ///< Extended Processor Signature and Feature Bits (in register `eax`)
 	EXTENDED_FEATURE_BITS      = 0x80000001U,  ///< Extended Feature Information (in register `ecx` and `edx`)
@@ -42,13 +43,14 @@ enum Function : uint32_t {
 /*! \brief Get CPU identification and feature information
  *
  * \param eax Requested feature
+ * \param ecx Requested subleaf (for functions having them)
  * \return Register values filled by instruction `cpuid` for the requested feature
  *
  * \see [ISDMv2, Chapter 3. CPUID - CPU Identification](intel_manual_vol2.pdf#page=292)
  */
-inline Reg get(Function eax) {
+inline Reg get(Function eax, uint32_t ecx = 0) {
 	Reg r;
-	asm volatile("cpuid \n\t" : "=a"(r.eax), "=b"(r.ebx), "=c"(r.ecx), "=d"(r.edx) : "0" (eax));
+	asm volatile("cpuid \n\t" : "=a"(r.eax), "=b"(r.ebx), "=c"(r.ecx), "=d"(r.edx) : "0" (eax), "2" (ecx));
 	return r;
 }
 
@@ -119,6 +121,18 @@ enum FeatureEDX : uint32_t {
 	FEATURE_PBE          = 1U << 31   ///< Pending Break Enable (PBE# pin) wakeup capability
 };
 
+enum StructuredFeatureEBX : uint32_t {
+	STRUCTURED_FEATURE_FSGSBASE   = 1U << 0,   ///< RDFSBASE, WRFSBASE, RDGSBASE and WRGSBASE instructions
+	STRUCTURED_FEATURE_BMI1       = 1U << 3,   ///< Bit Manipulation Instruction Set 1
+	STRUCTURED_FEATURE_AVX2       = 1U << 5,   ///< Advanced Vector Extensions 2
+	STRUCTURED_FEATURE_SMEP       = 1U << 7,   ///< Supervisor Mode Execution Prevention
+	STRUCTURED_FEATURE_BMI2       = 1U << 8,   ///< Bit Manipulation Instruction Set 2
+	STRUCTURED_FEATURE_ERMS       = 1U << 9,   ///< Enhanced REP MOVSB/STOSB
+	STRUCTURED_FEATURE_INVPCID    = 1U << 10,  ///< INVPCID instruction
+	STRUCTURED_FEATURE_SMAP       = 1U << 20,  ///< Supervisor Mode Access Prevention
+	STRUCTURED_FEATURE_CLFLUSHOPT = 1U << 23,  ///< CLFLUSHOPT instruction
+};
+
 enum ExtendedFeatureEDX : uint32_t {
 	EXTENDED_FEATURE_FPU      = 1U << 0,   ///< Onboard x87 FPU
 	EXTENDED_FEATURE_VME      = 1U << 1,   ///< Virtual 8086 mode extensions (such as VIF, VIP, PIV)
@@ -168,6 +182,16 @@ inline bool has(enum FeatureEDX feature) {
 	return (get(FEATURE_BITS).edx & feature) != 0;
 }
 
+/*! \brief Check if feature is provided by this system
+ *
+ * \param feature Structured extended feature to test
+ * \return `true` if available, `false` if either feature or the structured feature flags are unavailable
+ */
+inline bool has(enum StructuredFeatureEBX feature) {
+	return get(HIGHEST_FUNCTION_PARAMETER).eax >= STRUCTURED_FEATURE_BITS &&
+	       (get(STRUCTURED_FEATURE_BITS).ebx & feature) != 0;
+}
+
 /*! \brief Check if feature is provided by this system
  *
  * \param feature Extended feature to test
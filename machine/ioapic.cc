@@ -2,7 +2,9 @@
 
 #include "machine/apic.h"
 #include "machine/core.h"
+#include "machine/lapic.h"
 #include "debug/assert.h"
+#include "sync/locked.h"
 
 namespace IOAPIC {
 /*! \brief IOAPIC registers memory mapped into the CPU's address space.
@@ -24,6 +26,13 @@ const Index IOREDTBL_ENTRY_SIZE = 0x02;
 
 const uint8_t slot_max = 24;
 
+/*! \brief Serializes the (two step) register accesses
+ *
+ *  Besides the initialization, the I/O APIC is configured concurrently on different cores -- even in prologues
+ *  (e.g., of a \ref PollGate masking its line). Hence, interrupts are disabled while the lock is held.
+ */
+static Ticketlock lock{"IOAPIC"};
+
 RedirectionTableEntry readEntry(Index slot) {
     *IOREGSEL_REG = IOREDTBL_IDX + slot * IOREDTBL_ENTRY_SIZE;
     Register low = *IOWIN_REG;
@@ -39,15 +48,33 @@ void writeEntry(Index slot, RedirectionTableEntry entry) {
     *IOWIN_REG = entry.value_high;
 }
 
+/*! \brief Direct an entry to a set of cores
+ *
+ *  The logical IDs assigned by StuBS (one bit per core, see \ref APIC::getLogicalAPICID()) only exist in xAPIC
+ *  mode. In x2APIC mode, the local APICs interpret an 8 bit logical destination in cluster format (cluster in bits
+ *  4-7, member mask in bits 0-3), so cores beyond the fourth would never receive the interrupt. Instead, the entry
+ *  then uses the physical destination mode with the APIC ID of the first core of the set -- a physical destination
+ *  can not name several cores, so there is no load balancing by the hardware in this mode.
+ */
+static void direct(RedirectionTableEntry &entry, uint8_t logical_destination) {
+    if (LAPIC::isX2APIC()) {
+        entry.destination_mode = PHYSICAL;
+        entry.delivery_mode = FIXED;
+        entry.destination = APIC::getLAPICID(__builtin_ctz(logical_destination));
+    } else {
+        entry.destination_mode = LOGICAL;
+        entry.delivery_mode = LOWEST_PRIORITY;
+        entry.destination = logical_destination;
+    }
+}
+
 void init() {
     for (uint8_t slot = 0; slot < slot_max; slot++) {
         RedirectionTableEntry entry = readEntry(slot);
-        entry.destination = (1 << Core::count()) - 1;
+        direct(entry, (1 << Core::count()) - 1);
         entry.interrupt_mask = MASKED;
         entry.trigger_mode = EDGE;
         entry.polarity = HIGH;
-        entry.destination_mode = LOGICAL;
-        entry.delivery_mode = LOWEST_PRIORITY;
         entry.vector = Core::Interrupt::PANIC;
         writeEntry(slot, entry);
     }
@@ -59,6 +86,7 @@ void init() {
 
 void config(uint8_t slot, Core::Interrupt::Vector vector, TriggerMode trigger_mode, Polarity polarity) {
     assert(slot < slot_max);
+    Locked locked(lock);
     RedirectionTableEntry entry = readEntry(slot);
     entry.vector = vector;
     entry.trigger_mode = trigger_mode;
@@ -68,6 +96,7 @@ void config(uint8_t slot, Core::Interrupt::Vector vector, TriggerMode trigger_mo
 
 void allow(uint8_t slot) {
     assert(slot < slot_max);
+    Locked locked(lock);
     RedirectionTableEntry entry = readEntry(slot);
     entry.interrupt_mask = UNMASKED;
     writeEntry(slot, entry);
@@ -75,6 +104,7 @@ void allow(uint8_t slot) {
 
 void forbid(uint8_t slot) {
     assert(slot < slot_max);
+    Locked locked(lock);
     RedirectionTableEntry entry = readEntry(slot);
     entry.interrupt_mask = MASKED;
     writeEntry(slot, entry);
@@ -82,7 +112,49 @@ void forbid(uint8_t slot) {
 
 bool status(uint8_t slot) {
     assert(slot < slot_max);
+    Locked locked(lock);
     return readEntry(slot).interrupt_mask == UNMASKED;
 }
 
+Core::Interrupt::Vector getVector(uint8_t slot) {
+    assert(slot < slot_max);
+    Locked locked(lock);
+    return static_cast<Core::Interrupt::Vector>(readEntry(slot).vector);
+}
+
+void setDestination(uint8_t slot, uint8_t logical_destination) {
+    assert(slot < slot_max && logical_destination != 0);
+    Locked locked(lock);
+    RedirectionTableEntry entry = readEntry(slot);
+    direct(entry, logical_destination);
+    writeEntry(slot, entry);
+}
+
+uint8_t getDestination(uint8_t slot) {
+    assert(slot < slot_max);
+    uint8_t destination;
+    {
+        Locked locked(lock);
+        RedirectionTableEntry entry = readEntry(slot);
+        if (entry.destination_mode == LOGICAL)
+            return entry.destination;
+        destination = entry.destination;
+    }
+    // physical destination (x2APIC mode)
+    for (unsigned core = 0; core < Core::MAX; core++) {
+        if (Core::isOnline(core) && APIC::getLAPICID(core) == destination)
+            return APIC::getLogicalAPICID(core);
+    }
+    return 0;
+}
+
+void setAffinity(uint8_t slot, unsigned core) {
+    assert(core < Core::MAX);
+    setDestination(slot, APIC::getLogicalAPICID(core));
+}
+
+uint8_t slots() {
+    return slot_max;
+}
+
 }  // namespace IOAPIC
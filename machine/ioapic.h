@@ -68,4 +68,38 @@ namespace IOAPIC {
 	 *  \todo Implement Function
 	 */
 	bool status(uint8_t slot);
+
+	/*! \brief Get the interrupt vector configured for an external interrupt.
+	 *  \param slot Slot number of the interrupt
+	 *  \return Vector number
+	 */
+	Core::Interrupt::Vector getVector(uint8_t slot);
+
+	/*! \brief Select the cores an external interrupt is delivered to.
+	 *
+	 *  The interrupt is delivered to the core with the lowest priority among the set (in practice, most
+	 *  systems just pick the first one -- use a single core to control the destination precisely).
+	 *  In x2APIC mode (see \ref LAPIC::isX2APIC()), the flat logical IDs are not available: the entry is
+	 *  programmed in physical destination mode and the interrupt always goes to the first core of the set.
+	 *
+	 *  \param slot                Slot number of the interrupt
+	 *  \param logical_destination Mask of \ref APIC::getLogicalAPICID() "logical APIC IDs"
+	 */
+	void setDestination(uint8_t slot, uint8_t logical_destination);
+
+	/*! \brief Get the cores an external interrupt is delivered to.
+	 *  \param slot Slot number of the interrupt
+	 *  \return Mask of \ref APIC::getLogicalAPICID() "logical APIC IDs" (a single core in x2APIC mode)
+	 */
+	uint8_t getDestination(uint8_t slot);
+
+	/*! \brief Deliver an external interrupt to a single core only.
+	 *  \param slot Slot number of the interrupt
+	 *  \param core ID of the target core
+	 */
+	void setAffinity(uint8_t slot, unsigned core);
+
+	/*! \brief Get the number of slots (external interrupt sources) of the I/O APIC
+	 */
+	uint8_t slots();
 }  // namespace IOAPIC
@@ -1,5 +1,7 @@
 #include "machine/lapic.h"
 #include "machine/lapic_registers.h"
+#include "machine/core.h"
+#include "machine/cpuid.h"
 
 namespace LAPIC {
 
@@ -8,12 +10,21 @@ namespace LAPIC {
  */
 volatile uintptr_t base_address = 0xfee00000;
 
+bool x2apic = false;
+
 Register read(Index idx) {
+	if (x2apic) {
+		return static_cast<Register>(Core::readMSR(Core::MSR_X2APIC + (idx >> 4)));
+	}
 	return *reinterpret_cast<volatile Register *>(base_address + idx);
 }
 
 void write(Index idx, Register value) {
-	*reinterpret_cast<volatile Register *>(base_address + idx) = value;
+	if (x2apic) {
+		Core::writeMSR(Core::MSR_X2APIC + (idx >> 4), value);
+	} else {
+		*reinterpret_cast<volatile Register *>(base_address + idx) = value;
+	}
 }
 
 /*! \brief Local APIC ID (for Pentium 4 and newer)
@@ -144,15 +155,49 @@ union SpuriousInterruptVectorRegister  {
 static_assert(sizeof(SpuriousInterruptVectorRegister) == 4, "LAPIC Spurious Interrupt Vector has wrong size");
 
 uint8_t getID() {
+	if (x2apic) {
+		// the whole register contains the (32 bit) x2APIC ID
+		return static_cast<uint8_t>(read(Index::IDENTIFICATION));
+	}
 	IdentificationRegister ir;
 	return ir.apic_id;
 }
 
+bool enable() {
+	Core::MSR<Core::MSR_APIC_BASE> apic_base;
+	uint64_t value = apic_base.read();
+	if ((CPUID::get(CPUID::FEATURE_BITS).ecx & CPUID::FEATURE_X2APIC) != 0) {
+		// switching from xAPIC to x2APIC requires both bits set
+		// (the transition from disabled directly to x2APIC is illegal)
+		if ((value & Core::MSR_APIC_BASE_EXTD) == 0) {
+			apic_base.write(value | Core::MSR_APIC_BASE_EN);
+			apic_base.write(value | Core::MSR_APIC_BASE_EN | Core::MSR_APIC_BASE_EXTD);
+		}
+		x2apic = true;
+	}
+	return x2apic;
+}
+
+bool isX2APIC() {
+	return x2apic;
+}
+
 uint8_t getLogicalID() {
+	if (x2apic) {
+		// read only, derived from the x2APIC ID: cluster in bits 16-31, one bit set in 0-15
+		return static_cast<uint8_t>(read(Index::LOGICAL_DESTINATION));
+	}
 	LogicalDestinationRegister ldr;
 	return ldr.lapic_id;
 }
 
+void setLogicalID(uint8_t id) {
+	if (!x2apic) {
+		LogicalDestinationRegister ldr;
+		ldr.lapic_id = id;
+	}
+}
+
 uint8_t getVersion() {
 	VersionRegister vr;
 	return vr.version;
@@ -160,18 +205,20 @@ uint8_t getVersion() {
 
 void init(uint8_t logical_id) {
 	// reset logical destination ID
-	// can be set using setLogicalLAPICID()
-	LogicalDestinationRegister ldr;
-	ldr.lapic_id = logical_id;
+	// can be set using setLogicalLAPICID() -- ignored in x2APIC mode, where
+	// IPIs to groups are sent to each member individually
+	setLogicalID(logical_id);
 
 	// set task priority to 0 -> accept all interrupts
 	TaskPriorityRegister tpr;
 	tpr.task_prio = 0;
 	tpr.task_prio_sub = 0;
 
-	// set flat delivery mode
-	DestinationFormatRegister dfr;
-	dfr.model = Model::FLAT;
+	// set flat delivery mode (the register does not exist in x2APIC mode)
+	if (!x2apic) {
+		DestinationFormatRegister dfr;
+		dfr.model = Model::FLAT;
+	}
 
 	// use 255 as spurious vector, enable APIC and disable focus processor
 	SpuriousInterruptVectorRegister sivr;
@@ -181,6 +228,12 @@ void init(uint8_t logical_id) {
 }
 
 void endOfInterrupt() {
+	if (x2apic) {
+		// a single MSR write, no serialization with a dummy read required
+		write(EOI, 0);
+		return;
+	}
+
 	// dummy read
 	read(SPURIOUS_INTERRUPT_VECTOR);
 
@@ -17,6 +17,22 @@
  *  \see [ISDMv3 10.4 Local APIC](intel_manual_vol3.pdf#page=366)
  */
 namespace LAPIC {
+	/*! \brief Select the operating mode of the local APIC of the calling CPU core
+	 *
+	 *  Switches to x2APIC mode if supported by the processor (see \ref CPUID::FEATURE_X2APIC), which
+	 *  replaces the memory mapped registers by MSRs: IPIs are sent with a single write (without polling
+	 *  the delivery status) and the \ref endOfInterrupt() is cheaper. Otherwise, the xAPIC mode is kept.
+	 *
+	 *  \note Must be called on every core before accessing its local APIC.
+	 *  \return `true` if x2APIC mode is used
+	 *  \see [ISDMv3 10.12 Extended XAPIC (x2APIC)](intel_manual_vol3.pdf#page=404)
+	 */
+	bool enable();
+
+	/*! \brief Check if the local APICs are operated in x2APIC mode
+	 */
+	bool isX2APIC();
+
 	/*! \brief Initialized the local APIC of the calling CPU core and sets the logical LAPIC ID in the LDR register
 	 *  \param logical_id APIC ID to be set
 	 */
@@ -40,6 +56,7 @@ namespace LAPIC {
 	uint8_t getLogicalID();
 
 	/*! \brief Set the Logical ID of the current core's LAPIC
+	 *  \note Has no effect in x2APIC mode (the register is read only)
 	 *  \param id new Logical ID
 	 */
 	void setLogicalID(uint8_t id);
@@ -60,6 +77,7 @@ namespace IPI {
 
 	/*! \brief Check if the previously sent IPI has reached its destination.
 	 *
+	 *  \note Always `true` in x2APIC mode, which has no delivery status
 	 *  \return `true` if the previous IPI was accepted from its target processor, otherwise `false`
 	 */
 	bool isDelivered();
@@ -71,6 +89,10 @@ namespace IPI {
 	void send(uint8_t destination, uint8_t vector);
 
 	/*! \brief Send an Inter-Processor Interrupt (IPI) to a group of processors
+	 *
+	 * In x2APIC mode, the logical IDs assigned by StuBS are not available; the IPI is sent to each
+	 * processor of the group individually instead.
+	 *
 	 * \param logical_destination Mask containing the logical APIC IDs of the target processors (use APIC::getLogicalLAPICID())
 	 * \param vector              Interrupt vector number to be triggered
 	 */
@@ -121,6 +143,8 @@ namespace Timer {
 	 * timer is disabled again.
 	 *
 	 * \note The timer is counting towards zero.
+	 * \note The result is cached, so the (10 ms) measurement is only done once.
+	 *       Besides, the TSC frequency is gathered on the fly (see \ref TSC::setTicks).
 	 *
 	 * \return Number of LAPIC-timer ticks per millisecond
 	 */
@@ -138,5 +162,30 @@ namespace Timer {
 	 */
 	void set(uint32_t counter, uint8_t divide, uint8_t vector, bool periodic, bool masked = false);
 
+	/*! \brief Check if the LAPIC timer supports the TSC-deadline mode
+	 *
+	 * \see [ISDMv3 10.5.4.1 TSC-Deadline Mode](intel_manual_vol3.pdf#page=379)
+	 */
+	bool hasDeadline();
+
+	/*! \brief Switch the LAPIC timer into TSC-deadline mode.
+	 *
+	 * The timer stays disarmed until \ref arm() is called.
+	 *
+	 *  \param vector   Interrupt vector number to be triggered once the deadline is reached
+	 *  \param masked   If set, interrupts on expiry are suppressed
+	 */
+	void setDeadline(uint8_t vector, bool masked = false);
+
+	/*! \brief (Re)arm the timer in TSC-deadline mode
+	 *
+	 * A single interrupt is triggered as soon as the timestamp counter reaches
+	 * `deadline` (immediately, if it is already in the past). A new value
+	 * replaces the pending deadline.
+	 *
+	 *  \param deadline Absolute TSC value, `0` disarms the timer
+	 */
+	void arm(uint64_t deadline);
+
 }  // namespace Timer
 }  // namespace LAPIC
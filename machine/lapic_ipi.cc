@@ -1,4 +1,6 @@
 #include "machine/lapic_registers.h"
+#include "machine/apic.h"
+#include "machine/core.h"
 
 namespace LAPIC {
 namespace IPI {
@@ -170,17 +172,32 @@ union InterruptCommand {
 	}
 
 	void send() const {
-		write(INTERRUPT_COMMAND_REGISTER_HIGH, value_high);
-		write(INTERRUPT_COMMAND_REGISTER_LOW, value_low);
+		if (x2apic) {
+			// single 64 bit register with a 32 bit destination in the high half
+			Core::writeMSR(Core::MSR_X2APIC + (INTERRUPT_COMMAND_REGISTER_LOW >> 4),
+			               static_cast<uint64_t>(destination) << 32 | value_low);
+		} else {
+			write(INTERRUPT_COMMAND_REGISTER_HIGH, value_high);
+			write(INTERRUPT_COMMAND_REGISTER_LOW, value_low);
+		}
 	}
 
 	bool isSendPending() {
+		if (x2apic) {
+			return false;
+		}
 		value_low = read(INTERRUPT_COMMAND_REGISTER_LOW);
 		return delivery_status == DeliveryStatus::SEND_PENDING;
 	}
 
  private:
 	void readRegister() {
+		if (x2apic) {
+			// no need to wait for previous IPIs, all fields will be set
+			value_low = 0;
+			value_high = 0;
+			return;
+		}
 		while (isSendPending()) {}
 		value_high = read(INTERRUPT_COMMAND_REGISTER_HIGH);
 	}
@@ -198,6 +215,14 @@ void send(uint8_t destination, uint8_t vector) {
 }
 
 void sendGroup(uint8_t logical_destination, uint8_t vector) {
+	if (x2apic) {
+		for (uint8_t core = 0; core < Core::MAX; core++) {
+			if ((logical_destination & APIC::getLogicalAPICID(core)) != 0) {
+				send(APIC::getLAPICID(core), vector);
+			}
+		}
+		return;
+	}
 	InterruptCommand ic(logical_destination, vector, DestinationMode::LOGICAL);
 	ic.send();
 }
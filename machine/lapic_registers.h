@@ -10,6 +10,9 @@ namespace LAPIC {
 	// Memory Mapped Base Address
 	extern volatile uintptr_t base_address;
 
+	// Registers are accessed via MSRs (x2APIC mode) instead of MMIO
+	extern bool x2apic;
+
 	typedef uint32_t Register;
 
 	/*! \brief Register Offset Index
@@ -24,6 +27,7 @@ namespace LAPIC {
 		LOGICAL_DESTINATION             = 0x0d0,  ///< Logical Destination Register, R/W
 		DESTINATION_FORMAT              = 0x0e0,  ///< Destination Format Register, bits 0-27 RO, bits 28-31 R/W
 		SPURIOUS_INTERRUPT_VECTOR       = 0x0f0,  ///< Spurious Interrupt Vector Register, bits 0-8 R/W, bits 9-1 R/W
+		// In x2APIC mode, the Interrupt Command Register is a single 64 bit register at the LOW index
 		INTERRUPT_COMMAND_REGISTER_LOW  = 0x300,  ///< Interrupt Command Register 1, R/W
 		INTERRUPT_COMMAND_REGISTER_HIGH = 0x310,  ///< Interrupt Command Register 2, R/W
 		TIMER_CONTROL                   = 0x320,  ///< LAPIC timer control register, R/W
@@ -33,6 +37,8 @@ namespace LAPIC {
 	};
 
 	/*! \brief Get value from APIC register
+	 *
+	 * Uses MMIO in xAPIC mode and the MSR `MSR_X2APIC + idx / 16` in x2APIC mode.
 	 *
 	 * \param idx Register Offset Index
 	 * \return current value of register
@@ -2,7 +2,9 @@
 #include "machine/lapic.h"
 #include "machine/lapic_registers.h"
 #include "machine/core.h"
+#include "machine/cpuid.h"
 #include "machine/pit.h"
+#include "machine/tsc.h"
 #include "debug/assert.h"
 
 namespace LAPIC {
@@ -80,16 +82,28 @@ Register getClockDiv(uint8_t div) {
 	return div_masks[trail];
 }
 
+// Ticks per milliseconds (the bus frequency is the same for all cores)
+static uint32_t ticks_value = 0;
+
 uint32_t ticks(void) {
+	if (ticks_value != 0) {
+		return ticks_value;
+	}
+
 	uint32_t start = UINT32_MAX;
 	set(start, 1, Core::Interrupt::TIMER, false, true);
 
 	assert(PIT::set(10000));
+	uint64_t tsc_start = TSC::read();
 	assert(PIT::waitForTimeout());
+	uint64_t tsc_end = TSC::read();
 	PIT::disable();
 
 	uint32_t end = read(TIMER_CURRENT_COUNTER);
-	return (start - end) / (10000 / 1000);
+	// Calibrate the TSC in the same window
+	TSC::setTicks((tsc_end - tsc_start) / (10000 / 1000));
+	ticks_value = (start - end) / (10000 / 1000);
+	return ticks_value;
 }
 
 void set(uint32_t counter, uint8_t divide, uint8_t vector, bool periodic, bool masked) {
@@ -108,5 +122,24 @@ void set(uint32_t counter, uint8_t divide, uint8_t vector, bool periodic, bool m
 	write(TIMER_INITIAL_COUNTER, initial);
 }
 
+bool hasDeadline() {
+	return CPUID::has(CPUID::FEATURE_TSC_DEADLINE);
+}
+
+void setDeadline(uint8_t vector, bool masked) {
+	ControlRegister control_register;
+	control_register.value = read(TIMER_CONTROL);
+	control_register.timer_mode = DEADLINE;
+	control_register.masked = masked ? MASKED : NOT_MASKED;
+	control_register.vector = vector;
+	write(TIMER_CONTROL, control_register.value);
+	// Order the LVT write before the first deadline (ISDMv3 10.5.4.1)
+	asm volatile("mfence" : : : "memory");
+}
+
+void arm(uint64_t deadline) {
+	Core::MSR<Core::MSR_TSC_DEADLINE>::write(deadline);
+}
+
 }  // namespace Timer
 }  // namespace LAPIC
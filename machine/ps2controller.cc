@@ -108,6 +108,10 @@ bool fetch(Key &pressed) {
 	return pressed.valid();
 }
 
+bool hasOutput() {
+	return (ctrl_port.inb() & HAS_OUTPUT) == HAS_OUTPUT;
+}
+
 void setRepeatRate(Speed speed, Delay delay) {
 	// TODO: You have to implement this method. Use sendData()
 	sendData(KEYBOARD_SET_SPEED);
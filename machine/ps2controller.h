@@ -48,6 +48,15 @@ void init();
  */
 bool fetch(Key &pressed);
 
+/*! \brief Check if the output buffer of the controller contains a byte
+ *
+ * Allows polling the controller in batches with \ref fetch (which also
+ * returns `false` if a byte did not yet complete a valid key).
+ *
+ * \return `true` if a byte can be fetched
+ */
+bool hasOutput();
+
 /*! \brief Delay before the keyboard starts repeating sending a pressed key
  */
 enum Delay {
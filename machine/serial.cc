@@ -1,35 +1,48 @@
 #include "machine/serial.h"
+#include "machine/ioport.h"
 
 Serial::Serial(ComPort port, BaudRate baud_rate, DataBits data_bits, StopBits stop_bits, Parity parity) : port(port) {
-	// TODO: Implement (if you want, optional exercise)
-	(void) baud_rate;
-	(void) data_bits;
-	(void) stop_bits;
-	(void) parity;
+	// Disable all interrupts
+	writeReg(INTERRUPT_ENABLE_REGISTER, 0);
+
+	// Set the baud rate divisor (requires the DLAB)
+	writeReg(LINE_CONTROL_REGISTER, DIVISOR_LATCH_ACCESS_BIT);
+	writeReg(DIVISOR_LOW_REGISTER, baud_rate & 0xff);
+	writeReg(DIVISOR_HIGH_REGISTER, (baud_rate >> 8) & 0xff);
+
+	// Character format (clears the DLAB)
+	writeReg(LINE_CONTROL_REGISTER, data_bits | stop_bits | parity);
+
+	// Enable and clear the FIFOs
+	writeReg(FIFO_CONTROL_REGISTER, ENABLE_FIFO | CLEAR_RECEIVE_FIFO | CLEAR_TRANSMIT_FIFO);
+
+	// Ready to send, interrupts are routed (but not enabled yet)
+	writeReg(MODEM_CONTROL_REGISTER, DATA_TERMINAL_READY | REQUEST_TO_SEND | OUT_2);
 }
 
 void Serial::writeReg(RegisterIndex reg, char out) {
-	// TODO: Implement (if you want, optional exercise)
-	(void) reg;
-	(void) out;
+	IOPort(port + reg).outb(out);
 }
 
 char Serial::readReg(RegisterIndex reg) {
-	// TODO: Implement (if you want, optional exercise)
-	(void) reg;
-	return '\0';
+	return IOPort(port + reg).inb();
 }
 
 int Serial::write(char out, bool blocking) {
-	// TODO: Implement (if you want, optional exercise)
-	(void) out;
-	(void) blocking;
-	return 0;
+	while ((readReg(LINE_STATUS_REGISTER) & TRANSMITTER_HOLDING_REGISTER) == 0) {
+		if (!blocking) {
+			return -1;
+		}
+	}
+	writeReg(TRANSMIT_BUFFER_REGISTER, out);
+	return static_cast<uint8_t>(out);
 }
 
 int Serial::read(bool blocking) {
-	// TODO: Implement (if you want, optional exercise)
-	(void) blocking;
-	return 0;
+	while ((readReg(LINE_STATUS_REGISTER) & DATA_READY) == 0) {
+		if (!blocking) {
+			return -1;
+		}
+	}
+	return static_cast<uint8_t>(readReg(RECEIVE_BUFFER_REGISTER));
 }
-
@@ -75,7 +75,7 @@ class Serial {
 		PARITY_SPACE = 56,
 	};
 
- private:
+ protected:
 	/*! \brief register index */
 	enum RegisterIndex {
 		// if Divisor Latch Access Bit [DLAB] = 0
@@ -115,6 +115,7 @@ class Serial {
 		CLEAR_TRANSMIT_FIFO = 1 << 2,
 		DMA_MODE_SELECT     = 1 << 3,
 		TRIGGER_RECEIVE     = 1 << 6,
+		TRIGGER_RECEIVE_14  = 3 << 6,  ///< interrupt after 14 bytes in the receive FIFO (16550)
 
 		// Line Control Register
 		                                    //  bits per character:  5   6   7   8
@@ -172,7 +173,6 @@ class Serial {
 	 */
 	void writeReg(RegisterIndex reg, char out);
 
- protected:
 	/*! \brief Selected COM port */
 	const ComPort port;
 
@@ -2,6 +2,7 @@
 #include "machine/core.h"
 #include "machine/cpuid.h"
 #include "machine/pit.h"
+#include "debug/assert.h"
 #include "debug/output.h"
 
 namespace TSC {
@@ -98,22 +99,35 @@ static uint32_t ticksByProcessorInfo(void) {
  * \return TSC ticks per millisecond
  */
 static uint32_t ticksByPIT(void) {
-	uint64_t ticks = 0;
-	// Implementation optional
-	return ticks;
+	const uint16_t us = 10000;
+	bool enabled = Core::Interrupt::disable();
+	if (!PIT::set(us)) {
+		Core::Interrupt::restore(enabled);
+		return 0;
+	}
+	uint64_t start = read();
+	PIT::waitForTimeout();
+	uint64_t end = read();
+	PIT::disable();
+	Core::Interrupt::restore(enabled);
+	return (end - start) / (us / 1000);
 }
 
 // Ticks per milliseconds
 static uint32_t ticks_value = 0;
 
 uint32_t ticks(bool use_pit) {
+	// Calibrate only once -- the frequency is the same on all cores
+	if (ticks_value != 0 && !use_pit) {
+		return ticks_value;
+	}
+
 	// Check processor info, at first
 	if (!use_pit) {
 		ticks_value = ticksByProcessorInfo();
 	}
 
 	// Alternatively: Use PIT for calibration
-	// Take care: Not yet implemented; optional
 	if (ticks_value == 0 || use_pit) {
 		ticks_value = ticksByPIT();
 	}
@@ -127,6 +141,12 @@ uint32_t ticks(bool use_pit) {
 	return ticks_value;
 }
 
+void setTicks(uint32_t ticks_per_ms) {
+	if (ticks_value == 0) {
+		ticks_value = ticks_per_ms;
+	}
+}
+
 bool available(const Instruction instruction) {
 	if (instruction == RDTSCP || instruction == RDTSCP_CPUID) {
 		return CPUID::has(CPUID::EXTENDED_FEATURE_RDTSCP);
@@ -136,14 +156,21 @@ bool available(const Instruction instruction) {
 }
 
 uint64_t nanoseconds(uint64_t delta) {
-	(void) delta;
-	// Implementation optional
-	return 0;
+	assert(ticks_value != 0);
+	// 128 bit intermediate: delta * 1000000 overflows after a few hours
+	return static_cast<unsigned __int128>(delta) * 1000000 / ticks_value;
+}
+
+uint64_t fromMicroseconds(uint64_t us) {
+	assert(ticks_value != 0);
+	return static_cast<unsigned __int128>(us) * ticks_value / 1000;
 }
 
 void delay(uint64_t us) {
-	(void) us;
-	// Implementation optional
+	uint64_t end = read() + fromMicroseconds(us);
+	while (read() < end) {
+		Core::pause();
+	}
 }
 
 }  // namespace TSC
@@ -94,12 +94,22 @@ namespace TSC {
 	 *  \param use_pit Enforces the usage of the PIT if set, otherwise the processor infos are queried, at first.
 	 *  \return Number of TSC ticks per milliseconds
 	 *
-	 *  \opt Implement calibration via PIT (in the local function ticksByPit()).
-	 *       For testing, it might be useful to compare the return values with different values of \p use_pit.
-	 *       The returned values should be similar :)
+	 *  \note The PIT calibration busy-waits for 10 ms (with interrupts disabled).
+	 *        Hence the result is cached: Subsequent calls (on any core) return
+	 *        it immediately unless \p use_pit enforces a new measurement.
 	 */
 	uint32_t ticks(bool use_pit = false);
 
+	/*! \brief Provide the TSC frequency measured elsewhere
+	 *
+	 *  Used by \ref LAPIC::Timer::ticks, which samples the TSC in the same PIT
+	 *  window, so that the system is calibrated only once.
+	 *  Ignored if the frequency is already known.
+	 *
+	 *  \param ticks_per_ms Number of TSC ticks per milliseconds
+	 */
+	void setTicks(uint32_t ticks_per_ms);
+
 	/*! \brief Convert a timestamp delta value to nanoseconds
 	 *
 	 * \note It is necessary to execute `TSC::ticks()` prior calling this function the first time,
@@ -107,19 +117,24 @@ namespace TSC {
 	 *
 	 *  \param delta Delta between two timestamps
 	 *  \return Equivalent time in nanoseconds
-	 *
-	 *  \opt Implement conversion
 	 */
 	uint64_t nanoseconds(uint64_t delta);
 
+	/*! \brief Convert a time span to a timestamp delta value
+	 *
+	 * \note Like \ref nanoseconds, it relies on the frequency cached by `TSC::ticks()`.
+	 *
+	 *  \param us Time span in microseconds
+	 *  \return Equivalent delta in TSC ticks
+	 */
+	uint64_t fromMicroseconds(uint64_t us);
+
 	/*! \brief Actively wait the provided waiting time
 	 *
 	 * \note It is necessary to execute `TSC::ticks()` prior calling this function the first time,
 	 *       since it uses the cached TSC frequency value gathered by `ticks()` for the calculation.
 	 *
 	 *  \param us waiting time in microseconds
-	 *
-	 *  \opt Implement conversion
 	 */
 	void delay(uint64_t us);
 }  // namespace TSC
@@ -1,16 +1,32 @@
+#include "boot/bootprofile.h"
 #include "boot/startup_ap.h"
+#include "debug/klog.h"
 #include "debug/output.h"
 #include "device/keyboard.h"
+#include "device/serialdevice.h"
+#include "device/serialstream.h"
 #include "device/watch.h"
 #include "interrupt/guard.h"
+#include "interrupt/remotecall.h"
 #include "machine/core.h"
 #include "machine/ioapic.h"
 #include "machine/lapic.h"
+#include "memory/pageframe.h"
 #include "thread/assassin.h"
+#include "thread/logthread.h"
+#include "thread/pollthread.h"
 #include "thread/scheduler.h"
 #include "thread/wakeup.h"
 #include "user/app1/appl.h"
 #include "user/app2/kappl.h"
+#ifdef BENCHMARK
+#include "user/bench/heapbench.h"
+#include "user/bench/rcubench.h"
+#include "user/bench/scanoutbench.h"
+#include "user/bench/serialbench.h"
+#include "user/bench/streambench.h"
+#include "user/bench/stringbench.h"
+#endif
 
 TextStream dout[Core::MAX]{
 	{0, TextMode::COLUMNS/2, 18, 21},
@@ -24,6 +40,9 @@ TextStream dout[Core::MAX]{
 };
 TextStream kout{0, TextMode::COLUMNS, 0, 17, true};
 
+// Kernel log output (separate from the per-core `sout` used by DBG)
+static SerialStream lout;
+
 Application app[Core::MAX + 1]{};
 KeyboardApplication kapp{};
 
@@ -32,36 +51,78 @@ const char * os_name = "MP" "StuBS";
 // Main function (the bootstrap processor starts here)
 extern "C" int main() {
 
+	PageFrame::init();
+	BootProfile::mark("page frames");
+
 	kout.reset();
 	DBG.reset();
 
 	unsigned int num_cpus = Core::count();
 	DBG_VERBOSE << "Number of CPUs: " << num_cpus << endl;
 
+	// Start application processors: The mandatory delay between the INIT and
+	// STARTUP IPIs is used for calibrating the timers (once for all cores)
+	ApplicationProcessor::init();
+	bool b = watch.windup(1000);
+	assert(b);
+	BootProfile::mark("timer calibration");
+	ApplicationProcessor::startup();
+	BootProfile::mark("AP startup");
+
+	// The APs boot while we initialize the devices
 	IOAPIC::init();
 
 	assassin.hire();
 	keyboard.plugin();
+	serial.plugin();
+#ifdef THREADED_IRQ
+	// drain the keyboard buffer in an interrupt thread
+	keyboard.threaded = true;
+#endif
 	wakeup.activate();
+	remotecall.activate();
+	BootProfile::mark("devices");
 
 	for (unsigned int i = 0; i < Core::MAX + 1; i++)
 		Scheduler::ready(&app[i]);
 
 	Scheduler::ready(&kapp);
-
-	bool b = watch.windup(1000);
-	assert(b);
-
-	// Start application processors
-	ApplicationProcessor::boot();
+	Scheduler::ready(&pollthread);
+
+	KLog::attach(&lout, KLog::INFO);
+	Scheduler::ready(&logthread);
+
+#ifdef BENCHMARK
+	for (unsigned int i = 0; i < Core::MAX; i++)
+		Scheduler::ready(&rcubench[i]);
+	for (unsigned int i = 0; i < Core::MAX; i++)
+		Scheduler::ready(&heapbench[i]);
+	Scheduler::ready(&serialbench);
+	Scheduler::ready(&scanoutbench);
+	Scheduler::ready(&stringbench);
+	for (unsigned int i = 0; i < 2; i++)
+		Scheduler::ready(&streambench[i]);
+#endif
+	BootProfile::mark("threads");
 
 	watch.activate();
 
 	DBG << "CPU " << Core::getID() << " ready" << endl;
+	KLog::info("CPU %u (LAPIC %u) ready", Core::getID(), LAPIC::getID());
 
 	DBG_VERBOSE << "CPU core " << static_cast<int>(Core::getID())
 	            << " / LAPIC " << static_cast<int>(LAPIC::getID()) << " in main_ap()" << endl;
 
+	BootProfile::mark("first thread");
+	// the APs are still booting -- include their phases
+	if (!BootProfile::await("AP online", Core::count() - 1, 1000)) {
+		KLog::warn("boot: only %u of %u cores online", Core::countOnline(), Core::count());
+	}
+	BootProfile::report();
+
+	// Let the APs enter the scheduler
+	ApplicationProcessor::release();
+
 	Guard::enter();
 	Core::Interrupt::enable();
 	Scheduler::schedule();
@@ -76,10 +137,16 @@ extern "C" int main_ap() {
 	DBG.reset();
 
 	DBG << "CPU " << Core::getID() << " ready" << endl;
+	KLog::info("CPU %u (LAPIC %u) ready", Core::getID(), LAPIC::getID());
 
 	DBG_VERBOSE << "CPU core " << static_cast<int>(Core::getID())
 	            << " / LAPIC " << static_cast<int>(LAPIC::getID()) << " in main_ap()" << endl;
 
+	BootProfile::mark("AP online");
+
+	// Wait for the BSP to finish the system initialization
+	ApplicationProcessor::wait();
+
 	Guard::enter();
 	Core::Interrupt::enable();
 	Scheduler::schedule();
@@ -0,0 +1,87 @@
+#include "memory/arena.h"
+#include "debug/assert.h"
+#include "machine/cache.h"
+#include "machine/core.h"
+#include "memory/pageframe.h"
+#include "thread/thread.h"
+
+// Header at the beginning of each chunk
+struct Arena::Chunk {
+    Chunk *prev;
+    unsigned order;
+};
+
+// Used on cores without an active thread (during boot)
+static struct cache_aligned Boot {
+    Arena arena;
+} boot[Core::MAX];
+
+bool Arena::grow(size_t size, size_t align) {
+    size_t header = (sizeof(Chunk) + align - 1) & ~(align - 1);
+    unsigned order = PageFrame::order(header + size);
+    if (order < CHUNK_ORDER)
+        order = CHUNK_ORDER;
+
+    Chunk *chunk;
+    if (order == CHUNK_ORDER && spare != nullptr) {
+        chunk = spare;
+        spare = nullptr;
+    } else {
+        chunk = reinterpret_cast<Chunk *>(PageFrame::allocate(order));
+        if (chunk == nullptr)
+            return false;
+    }
+    chunk->prev = current;
+    chunk->order = order;
+    current = chunk;
+    top = reinterpret_cast<uintptr_t>(chunk) + sizeof(Chunk);
+    end = reinterpret_cast<uintptr_t>(chunk) + (PageFrame::SIZE << order);
+    return true;
+}
+
+void Arena::drop(Chunk *chunk) {
+    if (chunk->order == CHUNK_ORDER && spare == nullptr)
+        spare = chunk;
+    else
+        PageFrame::free(chunk, chunk->order);
+}
+
+void *Arena::allocate(size_t size, size_t align) {
+    assert((align & (align - 1)) == 0);
+    uintptr_t address = (top + align - 1) & ~(align - 1);
+    if (current == nullptr || address + size > end || address + size < address) {
+        if (!grow(size, align))
+            return nullptr;
+        address = (top + align - 1) & ~(align - 1);
+    }
+    top = address + size;
+    return reinterpret_cast<void *>(address);
+}
+
+void Arena::release(const Mark &position) {
+    while (current != position.chunk) {
+        assert(current != nullptr && "mark does not belong to the arena");
+        Chunk *chunk = current;
+        current = chunk->prev;
+        drop(chunk);
+    }
+    if (current != nullptr) {
+        top = position.top;
+        end = reinterpret_cast<uintptr_t>(current) + (PageFrame::SIZE << current->order);
+    } else {
+        top = end = 0;
+    }
+}
+
+void Arena::reset() {
+    release(Mark{nullptr, 0});
+    if (spare != nullptr) {
+        PageFrame::free(spare, spare->order);
+        spare = nullptr;
+    }
+}
+
+Arena &Arena::scratch() {
+    Thread *thread = Core::getThread();
+    return thread != nullptr ? thread->scratch : boot[Core::getID()].arena;
+}
@@ -0,0 +1,114 @@
+/*! \file
+ *  \brief \ref Arena "Region allocator" for short-lived allocations
+ */
+
+#pragma once
+
+#include "types.h"
+
+/*! \brief Bump pointer allocator with scoped release
+ *  \ingroup memory
+ *
+ * Temporary buffers which live only during a single operation (e.g. the
+ * target of a symlink during a path walk or the intermediate data of an
+ * image decoder) do not need the bookkeeping of the \ref Heap: An arena
+ * hands out memory by advancing a pointer within its current *chunk* (taken
+ * from the \ref PageFrame "page frame allocator") and releases everything
+ * allocated after a \ref Mark at once. A \ref Scope does this automatically:
+ *
+ * \code{.cpp}
+ *  Arena::Scope scope(Arena::scratch());
+ *  char *buf = static_cast<char *>(Arena::scratch().allocate(len + 1));
+ *  ...  // released when leaving the block
+ * \endcode
+ *
+ * Requests exceeding a chunk get a chunk of their own. One released chunk is
+ * kept as spare, so a scope which is entered repeatedly does not touch the
+ * page frame allocator in the common case.
+ *
+ * An arena is not synchronized: each thread has its own \ref scratch arena.
+ */
+class Arena {
+	// Prevent copies and assignments
+	Arena(const Arena&)            = delete;
+	Arena& operator=(const Arena&) = delete;
+
+ public:
+	/// Order of a regular chunk (16 KiB)
+	static const unsigned CHUNK_ORDER = 2;
+
+ private:
+	struct Chunk;
+
+	Chunk *current;
+	uintptr_t top;
+	uintptr_t end;
+	// Released regular chunk, kept for reuse
+	Chunk *spare;
+
+	bool grow(size_t size, size_t align);
+	void drop(Chunk *chunk);
+
+ public:
+	/*! \brief Position in an arena
+	 */
+	struct Mark {
+		Chunk *chunk;
+		uintptr_t top;
+	};
+
+	/*! \brief Releases all allocations of an arena done during its lifetime
+	 */
+	class Scope {
+		// Prevent copies and assignments
+		Scope(const Scope&)            = delete;
+		Scope& operator=(const Scope&) = delete;
+
+		Arena &arena;
+		const Mark position;
+
+	 public:
+		explicit Scope(Arena &arena) : arena(arena), position(arena.mark()) {}
+
+		~Scope() {
+			arena.release(position);
+		}
+	};
+
+	Arena() : current(nullptr), top(0), end(0), spare(nullptr) {}
+
+	~Arena() {
+		reset();
+	}
+
+	/*! \brief Allocate memory
+	 *
+	 * \param size Number of bytes
+	 * \param align Alignment (a power of two)
+	 * \return Pointer to the uninitialized memory or `nullptr` if no chunk
+	 *         could be allocated
+	 */
+	void *allocate(size_t size, size_t align = 16);
+
+	/*! \brief Current position (for a later \ref release)
+	 */
+	Mark mark() const {
+		return Mark{current, top};
+	}
+
+	/*! \brief Release all allocations done after the mark was taken
+	 *
+	 * Marks have to be released in the reverse order they were taken.
+	 */
+	void release(const Mark &position);
+
+	/*! \brief Release all allocations and return all chunks
+	 */
+	void reset();
+
+	/*! \brief Arena of the active thread
+	 *
+	 * Before the first thread is running, a core local arena is used instead.
+	 */
+	static Arena &scratch();
+};
@@ -0,0 +1,458 @@
+#include "memory/heap.h"
+#include "debug/assert.h"
+#include "machine/core.h"
+#include "memory/heapprofile.h"
+#include "memory/pageframe.h"
+#include "sync/locked.h"
+#include "utils/alloc.h"
+#include "utils/string.h"
+
+namespace Heap {
+
+// Size of the chunk header
+static const size_t HEADER = 16;
+// Smallest chunk able to hold the free list links
+static const size_t MIN_CHUNK = 32;
+// Flags stored in the lower bits of the chunk size
+static const size_t INUSE = 1;
+static const size_t PREV_INUSE = 2;
+// Released to the bins even if small (aligned chunks would clog the lists)
+static const size_t UNCACHED = 4;
+static const size_t FLAGS = ALIGNMENT - 1;
+
+// Smallest region requested from the page frame allocator (2 MiB)
+static const unsigned GROW_ORDER = 9;
+
+struct Chunk {
+    // Size of the predecessor (only valid if it is free)
+    size_t prev_size;
+    // Size of this chunk (including header) and flags
+    size_t head;
+    // Free list links (only valid if this chunk is free)
+    Chunk *next;
+    Chunk *prev;
+
+    size_t size() const {
+        return head & ~FLAGS;
+    }
+
+    Chunk *following() const {
+        return reinterpret_cast<Chunk *>(reinterpret_cast<uintptr_t>(this) + size());
+    }
+
+    Chunk *preceding() const {
+        return reinterpret_cast<Chunk *>(reinterpret_cast<uintptr_t>(this) - prev_size);
+    }
+
+    void *payload() {
+        return reinterpret_cast<char *>(this) + HEADER;
+    }
+
+    static Chunk *of(void *ptr) {
+        return reinterpret_cast<Chunk *>(reinterpret_cast<char *>(ptr) - HEADER);
+    }
+};
+
+#ifdef HEAPPROF
+// Prefix of each allocation (right before the returned pointer)
+struct Tag {
+    const void *site;
+    uint32_t size;
+    uint16_t magic;
+    // The returned pointer is 2^shift bytes behind the chunk's payload
+    uint16_t shift;
+};
+
+static const uint16_t LIVE = 0x1ea5;
+static const uint16_t FREED = 0xdead;
+// Fill byte of released memory
+static const uint8_t POISON = 0xdf;
+
+static Tag *tagOf(void *ptr) {
+    return reinterpret_cast<Tag *>(ptr) - 1;
+}
+
+#ifndef NDEBUG
+// Check that a cached chunk was not written after its release
+static void verify(Chunk *chunk) {
+    Tag *tag = reinterpret_cast<Tag *>(chunk->payload());
+    assert(tag->magic == FREED && "corrupted heap");
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(tag + 1);
+    for (size_t i = 0; i < tag->size; i++)
+        assert(data[i] == POISON && "write after free");
+}
+#endif
+#endif
+
+// Segregated lists of small chunks (singly linked via `next`)
+static const unsigned CLASSES = SMALL_MAX / ALIGNMENT - 1;
+static Chunk *small[CLASSES];
+
+// Bins of free chunks: bin `i` holds sizes [2^(i+5), 2^(i+6))
+static const unsigned BINS = 32;
+static Chunk *bin[BINS];
+
+static Stats statistics;
+
+static Ticketlock lock{"Heap"};
+
+static unsigned smallClass(size_t size) {
+    return size / ALIGNMENT - 2;
+}
+
+static unsigned binIndex(size_t size) {
+    unsigned i = 63 - __builtin_clzll(size) - 5;
+    return i < BINS ? i : BINS - 1;
+}
+
+// Chunk size required for a payload of `size` bytes (0 on overflow)
+static size_t chunkSize(size_t size) {
+    if (size > (__SIZE_MAX__ >> 1))
+        return 0;
+    size_t csize = (size + HEADER + FLAGS) & ~FLAGS;
+    return csize < MIN_CHUNK ? MIN_CHUNK : csize;
+}
+
+static void insert(Chunk *chunk) {
+    Chunk *&first = bin[binIndex(chunk->size())];
+    chunk->prev = nullptr;
+    chunk->next = first;
+    if (first != nullptr)
+        first->prev = chunk;
+    first = chunk;
+}
+
+static void unlink(Chunk *chunk) {
+    if (chunk->prev != nullptr)
+        chunk->prev->next = chunk->next;
+    else
+        bin[binIndex(chunk->size())] = chunk->next;
+    if (chunk->next != nullptr)
+        chunk->next->prev = chunk->prev;
+}
+
+// Turn `chunk` (with flags of the predecessor intact) into a free chunk,
+// coalesce it with its free neighbours and put it into its bin
+static void release(Chunk *chunk, size_t size) {
+    if ((chunk->head & PREV_INUSE) == 0) {
+        Chunk *prev = chunk->preceding();
+        unlink(prev);
+        size += prev->size();
+        chunk = prev;
+    }
+    Chunk *next = reinterpret_cast<Chunk *>(reinterpret_cast<uintptr_t>(chunk) + size);
+    if ((next->head & INUSE) == 0) {
+        unlink(next);
+        size += next->size();
+        next = next->following();
+    }
+    // there are never two adjacent free chunks, hence the predecessor is in use
+    chunk->head = size | PREV_INUSE;
+    next->prev_size = size;
+    next->head &= ~PREV_INUSE;
+    insert(chunk);
+}
+
+// Shrink the used `chunk` to `size`, releasing the remainder (if large enough)
+static void trim(Chunk *chunk, size_t size) {
+    size_t rest = chunk->size() - size;
+    if (rest < MIN_CHUNK)
+        return;
+    chunk->head = size | (chunk->head & FLAGS);
+    Chunk *remainder = chunk->following();
+    remainder->head = rest | PREV_INUSE;
+    release(remainder, rest);
+}
+
+// Take a fitting chunk from the bins and mark it as used
+static Chunk *take(size_t size) {
+    for (unsigned i = binIndex(size); i < BINS; i++) {
+        for (Chunk *chunk = bin[i]; chunk != nullptr; chunk = chunk->next) {
+            if (chunk->size() < size)
+                continue;
+            unlink(chunk);
+            chunk->head |= INUSE;
+            chunk->following()->head |= PREV_INUSE;
+            trim(chunk, size);
+            return chunk;
+        }
+    }
+    return nullptr;
+}
+
+// Add the memory [from, to) to the heap
+static void add(uintptr_t from, uintptr_t to) {
+    from = (from + FLAGS) & ~FLAGS;
+    to &= ~FLAGS;
+    if (to <= from || to - from < HEADER + MIN_CHUNK)
+        return;
+    size_t size = to - from - HEADER;
+    Chunk *chunk = reinterpret_cast<Chunk *>(from);
+    // the sentinel at the end is permanently in use and terminates coalescing
+    Chunk *sentinel = reinterpret_cast<Chunk *>(from + size);
+    sentinel->head = INUSE | PREV_INUSE;
+    chunk->head = size | PREV_INUSE | INUSE;
+    release(chunk, size);
+    statistics.total += size;
+    statistics.regions++;
+}
+
+// Add a region of page frames large enough for a chunk of `csize` bytes
+static bool grow(size_t csize) {
+    unsigned order = PageFrame::order(csize + HEADER);
+    if (order < GROW_ORDER)
+        order = GROW_ORDER;
+    void *region = PageFrame::allocate(order);
+    if (region == nullptr)
+        return false;
+    uintptr_t from = reinterpret_cast<uintptr_t>(region);
+    add(from, from + (PageFrame::SIZE << order));
+    return true;
+}
+
+static void *allocate(size_t size) {
+    size_t csize = chunkSize(size);
+    if (size == 0 || csize == 0)
+        return nullptr;
+
+    Locked locked(lock);
+    Chunk *chunk = nullptr;
+    if (csize <= SMALL_MAX && small[smallClass(csize)] != nullptr) {
+        chunk = small[smallClass(csize)];
+        small[smallClass(csize)] = chunk->next;
+        statistics.cached -= csize;
+#if defined(HEAPPROF) && !defined(NDEBUG)
+        verify(chunk);
+#endif
+    } else {
+        chunk = take(csize);
+        if (chunk == nullptr && grow(csize))
+            chunk = take(csize);
+    }
+    if (chunk == nullptr) {
+        statistics.failures++;
+        return nullptr;
+    }
+    statistics.used += chunk->size();
+    statistics.allocations++;
+    return chunk->payload();
+}
+
+static void *allocateAligned(size_t alignment, size_t size) {
+    if (alignment <= ALIGNMENT)
+        return allocate(size);
+    size_t csize = chunkSize(size);
+    if (size == 0 || csize == 0 || (alignment & (alignment - 1)) != 0 || alignment > (__SIZE_MAX__ >> 2))
+        return nullptr;
+
+    Locked locked(lock);
+    // large enough for a leading remainder of at least MIN_CHUNK bytes
+    Chunk *chunk = take(csize + alignment + MIN_CHUNK);
+    if (chunk == nullptr && grow(csize + alignment + MIN_CHUNK))
+        chunk = take(csize + alignment + MIN_CHUNK);
+    if (chunk == nullptr) {
+        statistics.failures++;
+        return nullptr;
+    }
+    uintptr_t payload = reinterpret_cast<uintptr_t>(chunk->payload());
+    uintptr_t aligned = (payload + alignment - 1) & ~(alignment - 1);
+    if (aligned != payload) {
+        if (aligned - payload < MIN_CHUNK)
+            aligned += alignment;
+        size_t lead = aligned - payload;
+        Chunk *result = Chunk::of(reinterpret_cast<void *>(aligned));
+        result->head = (chunk->size() - lead) | INUSE;
+        chunk->head = lead | (chunk->head & FLAGS);
+        release(chunk, lead);
+        chunk = result;
+    }
+    chunk->head |= UNCACHED;
+    trim(chunk, csize);
+    statistics.used += chunk->size();
+    statistics.allocations++;
+    return chunk->payload();
+}
+
+static void deallocate(void *ptr) {
+    Chunk *chunk = Chunk::of(ptr);
+    size_t size = chunk->size();
+    assert((chunk->head & INUSE) != 0 && "double free or corrupted heap");
+
+    Locked locked(lock);
+    statistics.used -= size;
+    statistics.releases++;
+    if (size <= SMALL_MAX && (chunk->head & UNCACHED) == 0) {
+        // stays in use from the bins' point of view
+        chunk->next = small[smallClass(size)];
+        small[smallClass(size)] = chunk;
+        statistics.cached += size;
+    } else {
+        release(chunk, size);
+    }
+}
+
+#ifndef HEAPPROF
+// Try to resize the chunk in place (not with tags, see realloc)
+static bool resize(Chunk *chunk, size_t csize) {
+    Locked locked(lock);
+    size_t size = chunk->size();
+    if (csize > size) {
+        // absorb the free successor
+        Chunk *next = chunk->following();
+        if ((next->head & INUSE) != 0 || size + next->size() < csize)
+            return false;
+        unlink(next);
+        chunk->head = (size + next->size()) | (chunk->head & FLAGS);
+        chunk->following()->head |= PREV_INUSE;
+    } else if (size <= SMALL_MAX && (chunk->head & UNCACHED) == 0) {
+        // cached chunks are not split
+        return true;
+    }
+    trim(chunk, csize);
+    statistics.used += chunk->size() - size;
+    return true;
+}
+#endif
+
+#ifdef HEAPPROF
+static void *tagged(void *block, unsigned shift, size_t size, const void *site) {
+    if (block == nullptr)
+        return nullptr;
+    void *ptr = reinterpret_cast<char *>(block) + (1UL << shift);
+    *tagOf(ptr) = Tag{site, static_cast<uint32_t>(size), LIVE, static_cast<uint16_t>(shift)};
+    HeapProfile::allocated(site, size);
+    return ptr;
+}
+
+void *allocateFor(size_t size, const void *site) {
+    if (size == 0 || size > UINT32_MAX)
+        return nullptr;
+    return tagged(allocate(size + sizeof(Tag)), __builtin_ctzll(sizeof(Tag)), size, site);
+}
+
+static void *allocateAlignedFor(size_t alignment, size_t size, const void *site) {
+    if (alignment <= sizeof(Tag))
+        return allocateFor(size, site);
+    if (size == 0 || size > UINT32_MAX || (alignment & (alignment - 1)) != 0)
+        return nullptr;
+    // the tag occupies the end of the first aligned block
+    return tagged(allocateAligned(alignment, size + alignment), __builtin_ctzll(alignment), size, site);
+}
+
+static void deallocateTagged(void *ptr) {
+    Tag *tag = tagOf(ptr);
+    assert(tag->magic != FREED && "double free");
+    assert(tag->magic == LIVE && "free of an invalid pointer");
+    HeapProfile::released(tag->site, tag->size);
+#ifndef NDEBUG
+    memset(ptr, POISON, tag->size);
+#endif
+    tag->magic = FREED;
+    deallocate(reinterpret_cast<char *>(ptr) - (1UL << tag->shift));
+}
+#endif
+
+size_t usable(void *ptr) {
+#ifdef HEAPPROF
+    size_t offset = 1UL << tagOf(ptr)->shift;
+    return Chunk::of(reinterpret_cast<char *>(ptr) - offset)->size() - HEADER - offset;
+#else
+    return Chunk::of(ptr)->size() - HEADER;
+#endif
+}
+
+// Copy the statistics (with the lock held)
+static Stats collect() {
+    Stats s = statistics;
+    // the largest chunk is in the highest non-empty bin
+    s.largest = 0;
+    for (unsigned i = BINS; i-- > 0 && s.largest == 0; )
+        for (Chunk *chunk = bin[i]; chunk != nullptr; chunk = chunk->next)
+            if (chunk->size() > s.largest)
+                s.largest = chunk->size();
+    return s;
+}
+
+Stats stats() {
+    Locked locked(lock);
+    return collect();
+}
+
+bool tryStats(Stats &s) {
+    Locked locked(lock, false);
+    if (!locked.isHeld())
+        return false;
+    s = collect();
+    return true;
+}
+
+}  // namespace Heap
+
+extern "C" void *malloc(size_t size) {
+#ifdef HEAPPROF
+    return Heap::allocateFor(size, __builtin_return_address(0));
+#else
+    return Heap::allocate(size);
+#endif
+}
+
+extern "C" void free(void *ptr) {
+    if (ptr != nullptr) {
+#ifdef HEAPPROF
+        Heap::deallocateTagged(ptr);
+#else
+        Heap::deallocate(ptr);
+#endif
+    }
+}
+
+extern "C" void *aligned_alloc(size_t alignment, size_t size) {
+#ifdef HEAPPROF
+    return Heap::allocateAlignedFor(alignment, size, __builtin_return_address(0));
+#else
+    return Heap::allocateAligned(alignment, size);
+#endif
+}
+
+extern "C" void *realloc(void *ptr, size_t size) {
+    if (ptr == nullptr)
+        return malloc(size);
+    if (size == 0) {
+        free(ptr);
+        return nullptr;
+    }
+#ifdef HEAPPROF
+    // always moved, the tag has to be updated anyway
+    void *moved = Heap::allocateFor(size, __builtin_return_address(0));
+    if (moved != nullptr) {
+        size_t old = Heap::tagOf(ptr)->size;
+        memcpy(moved, ptr, old < size ? old : size);
+        free(ptr);
+    }
+#else
+    size_t csize = Heap::chunkSize(size);
+    if (csize == 0)
+        return nullptr;
+    if (Heap::resize(Heap::Chunk::of(ptr), csize))
+        return ptr;
+    void *moved = malloc(size);
+    if (moved != nullptr) {
+        memcpy(moved, ptr, Heap::usable(ptr));
+        free(ptr);
+    }
+#endif
+    return moved;
+}
+
+extern "C" void *calloc(size_t nmemb, size_t size) {
+    if (nmemb != 0 && size > __SIZE_MAX__ / nmemb)
+        return nullptr;
+#ifdef HEAPPROF
+    void *ptr = Heap::allocateFor(nmemb * size, __builtin_return_address(0));
+#else
+    void *ptr = malloc(nmemb * size);
+#endif
+    if (ptr != nullptr)
+        memset(ptr, 0, nmemb * size);
+    return ptr;
+}
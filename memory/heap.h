@@ -0,0 +1,94 @@
+/*! \file
+ *  \brief The kernel \ref Heap behind \ref malloc() and `new`
+ */
+
+/*! \defgroup memory Memory management
+ *  \brief Allocation of (physical) memory
+ */
+
+#pragma once
+
+#include "types.h"
+
+/*! \brief Kernel heap
+ *  \ingroup memory
+ *
+ * The heap takes its memory in regions of (at least) 2 MiB from the
+ * \ref PageFrame "page frame allocator" whenever its free chunks do not
+ * suffice. It implements the C interface declared in `utils/alloc.h`, which
+ * is also used by `operator new` and `operator delete`.
+ *
+ * Memory is managed in *chunks* with a 16 byte header (and aligned to 16
+ * bytes), carrying the chunk size, whether the chunk is in use and whether
+ * its predecessor is in use -- and, in the latter case, the predecessor's
+ * size (boundary tag).
+ *
+ *  - Small chunks (up to \ref SMALL_MAX bytes) are kept in segregated free
+ *    lists, one per 16 byte size class. They are neither split nor
+ *    coalesced when they are freed, so allocation and release are O(1).
+ *  - All other free chunks are coalesced with their free neighbours
+ *    immediately and kept in doubly linked bins, one per power of two.
+ *    An allocation takes the first fitting chunk of the smallest suitable
+ *    bin and splits off the rest.
+ *
+ * All operations are serialized by a spin lock held with interrupts
+ * disabled, so the heap may be used by threads and epilogues (but not by
+ * prologues) on all cores.
+ *
+ * With `-DHEAPPROF`, each allocation carries a tag for the
+ * \ref HeapProfile "heap profiler".
+ */
+namespace Heap {
+
+/// Alignment of all returned pointers
+const size_t ALIGNMENT = 16;
+
+/// Largest chunk (including header) served from the segregated lists
+const size_t SMALL_MAX = 1024;
+
+/*! \brief Usage statistics
+ */
+struct Stats {
+	size_t total;        ///< Managed memory in bytes
+	size_t used;         ///< Bytes in chunks handed out (including headers)
+	size_t cached;       ///< Bytes in freed small chunks
+	size_t regions;      ///< Number of regions taken from the page frame allocator
+	uint64_t allocations;  ///< Number of successful allocations
+	uint64_t releases;   ///< Number of released allocations
+	uint64_t failures;   ///< Number of failed allocations
+	size_t largest;      ///< Size of the largest free chunk (excluding cached ones)
+};
+
+/*! \brief Usable size of an allocated block
+ *
+ * \param ptr Pointer returned by \ref malloc()
+ * \return Number of bytes which may be used (at least the requested size)
+ */
+size_t usable(void *ptr);
+
+/*! \brief Retrieve the usage statistics
+ */
+Stats stats();
+
+/*! \brief Retrieve the usage statistics unless the heap is locked
+ *
+ * For callers which might have interrupted the holder of the lock (like the
+ * \ref GDB_Stub), where waiting would never end.
+ * \param s Receives the statistics
+ * \return `false` if the heap is locked
+ */
+bool tryStats(Stats &s);
+
+#ifdef HEAPPROF
+/*! \brief \ref malloc() on behalf of a call site
+ *
+ * Used by `operator new` to account the allocation to its caller.
+ *
+ * \param size Requested size of memory in bytes
+ * \param site Call site shown in the \ref HeapProfile
+ * \return Pointer to memory or `nullptr`
+ */
+void *allocateFor(size_t size, const void *site);
+#endif
+
+}  // namespace Heap
@@ -0,0 +1,164 @@
+#include "memory/heapprofile.h"
+#include "machine/core.h"
+#include "memory/heap.h"
+#include "memory/pageframe.h"
+#include "memory/slab.h"
+#include "object/outputstream.h"
+#include "sync/locked.h"
+
+namespace HeapProfile {
+
+#ifdef HEAPPROF
+struct Site {
+    const void *address;
+    uint64_t allocations;
+    size_t live;
+    size_t bytes;
+};
+
+// Open addressing table of call sites (never shrinks)
+static Site sites[SITES];
+// Call sites which did not fit into the table
+static Site unknown;
+
+static size_t live_bytes = 0;
+static size_t peak_bytes = 0;
+static uint64_t histogram[BUCKETS];
+
+static Ticketlock lock{"HeapProfile"};
+
+// Entry of a call site (registered if unknown)
+static Site &lookup(const void *address) {
+    unsigned start = (reinterpret_cast<uintptr_t>(address) * 0x9e3779b97f4a7c15ULL >> 32) % SITES;
+    for (unsigned i = 0; i < SITES; i++) {
+        Site &site = sites[(start + i) % SITES];
+        if (site.address == address)
+            return site;
+        if (site.address == nullptr) {
+            site.address = address;
+            return site;
+        }
+    }
+    return unknown;
+}
+
+void allocated(const void *site, size_t size) {
+    unsigned bucket = size == 0 ? 0 : 63 - __builtin_clzll(size);
+    if (bucket >= BUCKETS)
+        bucket = BUCKETS - 1;
+
+    Locked locked(lock);
+    Site &s = lookup(site);
+    s.allocations++;
+    s.live++;
+    s.bytes += size;
+    histogram[bucket]++;
+    live_bytes += size;
+    if (live_bytes > peak_bytes)
+        peak_bytes = live_bytes;
+}
+
+void released(const void *site, size_t size) {
+    Locked locked(lock);
+    Site &s = lookup(site);
+    s.live--;
+    s.bytes -= size;
+    live_bytes -= size;
+}
+
+bool reset(bool wait) {
+    Locked locked(lock, wait);
+    if (!locked.isHeld())
+        return false;
+    for (auto &site : sites)
+        site.allocations = 0;
+    unknown.allocations = 0;
+    for (auto &bucket : histogram)
+        bucket = 0;
+    peak_bytes = live_bytes;
+    return true;
+}
+
+// Print the call sites with the most live bytes
+static void profile(OutputStream &out) {
+    // Like the LockStat report, the profile is read without holding the
+    // lock (the stub might have interrupted its holder).
+    static const Site *sorted[SITES + 1];
+    unsigned n = 0;
+    for (unsigned i = 0; i <= SITES; i++) {
+        const Site *site = i < SITES ? &sites[i] : &unknown;
+        if (site->allocations == 0 && site->live == 0)
+            continue;
+        unsigned j = n++;
+        for (; j > 0 && sorted[j - 1]->bytes < site->bytes; j--)
+            sorted[j] = sorted[j - 1];
+        sorted[j] = site;
+    }
+
+    out << "profile: " << live_bytes << " bytes live, peak " << peak_bytes << endl;
+    out << "sizes: log2(bytes):count";
+    for (unsigned b = 0; b < BUCKETS; b++)
+        if (histogram[b] != 0)
+            out << " " << b << ":" << histogram[b];
+    out << endl;
+    out << "site: allocations, live (bytes)" << endl;
+    for (unsigned i = 0; i < n; i++) {
+        if (sorted[i] == &unknown)
+            out << "  unknown";
+        else
+            out << "  " << sorted[i]->address;
+        out << ": " << sorted[i]->allocations << ", " << sorted[i]->live << " (" << sorted[i]->bytes << ")" << endl;
+    }
+}
+#endif
+
+void report(OutputStream &out, bool wait) {
+    Heap::Stats heap;
+    if (!wait && !Heap::tryStats(heap)) {
+        out << "heap: busy" << endl;
+    } else {
+        if (wait)
+            heap = Heap::stats();
+        size_t unused = heap.total - heap.used - heap.cached;
+        out << "heap: " << heap.used << " of " << heap.total << " bytes used, " << heap.cached << " cached, "
+            << unused << " free in " << heap.regions << " regions" << endl;
+        out << "  largest free chunk " << heap.largest << " bytes, fragmentation "
+            << (unused == 0 ? 0 : 100 - heap.largest * 100 / unused) << "%" << endl;
+        out << "  " << heap.allocations << " allocations, " << heap.releases << " releases, "
+            << heap.failures << " failures" << endl;
+    }
+
+    PageFrame::Stats frames;
+    if (!wait && !PageFrame::tryStats(frames)) {
+        out << "page frames: busy" << endl;
+    } else {
+        if (wait)
+            frames = PageFrame::stats();
+        out << "page frames: " << frames.free << " of " << frames.total << " bytes free, " << frames.hot << " hot, "
+            << frames.allocations << " allocations, " << frames.failures << " failures" << endl;
+        out << "  free blocks per order:";
+        for (unsigned o = 0; o <= PageFrame::MAX_ORDER; o++)
+            out << " " << frames.blocks[o];
+        out << endl;
+    }
+
+    out << "slab cache: object size, objects used, slabs full/partial/empty, hits/allocations" << endl;
+    for (SlabCache *cache = SlabCache::getFirst(); cache != nullptr; cache = cache->getNext()) {
+        SlabCache::Stats slab;
+        if (!wait && !cache->tryStats(slab)) {
+            out << "  " << cache->getName() << ": busy" << endl;
+            continue;
+        }
+        if (wait)
+            slab = cache->stats();
+        out << "  " << cache->getName() << ": " << slab.size << ", " << slab.used << ", "
+            << slab.full << "/" << slab.partial << "/" << slab.empty << ", "
+            << slab.hits << "/" << slab.allocations << endl;
+    }
+
+#ifdef HEAPPROF
+    profile(out);
+#endif
+}
+
+}  // namespace HeapProfile
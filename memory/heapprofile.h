@@ -0,0 +1,71 @@
+/*! \file
+ *  \brief \ref HeapProfile "Memory usage report and heap allocation profiler"
+ */
+
+#pragma once
+
+#include "types.h"
+
+class OutputStream;
+
+/*! \brief Report of the memory allocators and (optional) heap profiler
+ *  \ingroup memory
+ *
+ * \ref report summarizes the \ref Heap (including its fragmentation, i.e.
+ * the share of free heap memory outside of the largest free chunk), the
+ * \ref PageFrame "page frame allocator" and all \ref SlabCache "slab caches"
+ * -- e.g. to \ref DBG, to a \ref SerialStream or via the `monitor heap`
+ * command of the \ref GDB_Stub.
+ *
+ * If the kernel is compiled with `-DHEAPPROF`, the heap additionally
+ * prefixes each allocation with a tag holding the call site (the return
+ * address of \ref malloc() or `operator new`) and the requested size. The
+ * profiler accounts allocations and releases per call site -- the live
+ * allocations of a site reveal leaks -- as well as the live and peak bytes
+ * and a histogram of the requested sizes. The tag detects double frees and
+ * frees of invalid pointers; debug builds (without `NDEBUG`) also poison
+ * released memory and check that small chunks are still poisoned when they
+ * are reused, catching writes after free.
+ */
+namespace HeapProfile {
+
+#ifdef HEAPPROF
+/// Number of distinct call sites tracked (further ones are accounted as unknown)
+const unsigned SITES = 128;
+
+/// Number of histogram buckets (bucket `i` counts sizes in `[2^i, 2^(i+1))`)
+const unsigned BUCKETS = 28;
+
+/*! \brief Account an allocation
+ *  \param site Call site
+ *  \param size Requested size
+ */
+void allocated(const void *site, size_t size);
+
+/*! \brief Account a release
+ *  \param site Call site of the allocation
+ *  \param size Requested size of the allocation
+ */
+void released(const void *site, size_t size);
+
+/*! \brief Clear the histogram, the peak and the allocation counters
+ *
+ * The live allocations are kept (they will be released later).
+ * \param wait `false` to give up if the profile is locked (see \ref report)
+ * \return `false` if nothing was cleared
+ */
+bool reset(bool wait = true);
+#endif
+
+/*! \brief Print the usage of the allocators (and the profile, if enabled)
+ *
+ * The \ref GDB_Stub might have stopped a core holding the lock of an
+ * allocator, which would never be released while the stub waits for it.
+ * Without `wait`, locked allocators are reported as busy instead.
+ *
+ *  \param out Output stream
+ *  \param wait `false` to skip allocators whose lock is held
+ */
+void report(OutputStream &out, bool wait = true);
+
+}  // namespace HeapProfile
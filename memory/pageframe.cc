@@ -0,0 +1,341 @@
+#include "memory/pageframe.h"
+#include "boot/multiboot/data.h"
+#include "debug/assert.h"
+#include "machine/cache.h"
+#include "machine/core.h"
+#include "sync/locked.h"
+
+extern "C" char ___KERNEL_START___;
+extern "C" char ___KERNEL_END___;
+
+namespace PageFrame {
+
+// Only the first 4 GiB are identity mapped
+static const uintptr_t LIMIT = 1ULL << 32;
+// Leave the first MiB (BIOS, relocated AP setup code) alone
+static const uintptr_t BASE = 1ULL << 20;
+
+// Frame state: Head frames of free blocks are marked with FREE | order,
+// head frames of allocated blocks with their order, all others with 0.
+static const uint8_t FREE = 0x80;
+static uint8_t *state = nullptr;
+static size_t frames = 0;
+// Address of frame 0 (aligned to the largest block size)
+static uintptr_t origin = 0;
+
+// Free blocks (linked within the free memory itself)
+struct Block {
+    Block *next;
+    Block *prev;
+};
+
+static Block *area[MAX_ORDER + 1];
+
+static Stats statistics;
+
+static Ticketlock lock{"PageFrame"};
+
+// Core local hot pages (linked via `next`)
+static struct cache_aligned {
+    Block *pages;
+    unsigned count;
+} local[Core::MAX];
+
+static size_t frameOf(const void *address) {
+    return (reinterpret_cast<uintptr_t>(address) - origin) / SIZE;
+}
+
+static Block *blockOf(size_t frame) {
+    return reinterpret_cast<Block *>(origin + frame * SIZE);
+}
+
+static void insert(Block *block, unsigned order) {
+    block->prev = nullptr;
+    block->next = area[order];
+    if (area[order] != nullptr)
+        area[order]->prev = block;
+    area[order] = block;
+    statistics.blocks[order]++;
+}
+
+static void unlink(Block *block, unsigned order) {
+    if (block->prev != nullptr)
+        block->prev->next = block->next;
+    else
+        area[order] = block->next;
+    if (block->next != nullptr)
+        block->next->prev = block->prev;
+    statistics.blocks[order]--;
+}
+
+// Free the block at `frame` and merge it with its buddies
+static void release(size_t frame, unsigned order) {
+    statistics.free += SIZE << order;
+    state[frame] = 0;
+    while (order < MAX_ORDER) {
+        size_t buddy = frame ^ (1UL << order);
+        if (buddy >= frames || state[buddy] != (FREE | order))
+            break;
+        unlink(blockOf(buddy), order);
+        state[buddy] = 0;
+        frame &= ~(1UL << order);
+        order++;
+    }
+    state[frame] = FREE | order;
+    insert(blockOf(frame), order);
+}
+
+// Take a block of the requested order, splitting larger ones if necessary
+static Block *take(unsigned order) {
+    unsigned o = order;
+    while (area[o] == nullptr)
+        if (++o > MAX_ORDER)
+            return nullptr;
+    Block *block = area[o];
+    unlink(block, o);
+    size_t frame = frameOf(block);
+    // return the upper halves
+    while (o > order) {
+        o--;
+        size_t buddy = frame + (1UL << o);
+        state[buddy] = FREE | o;
+        insert(blockOf(buddy), o);
+    }
+    state[frame] = order;
+    statistics.free -= SIZE << order;
+    return block;
+}
+
+unsigned order(size_t bytes) {
+    unsigned o = 0;
+    while ((SIZE << o) < bytes)
+        o++;
+    return o;
+}
+
+void *allocate(unsigned order) {
+    if (order > MAX_ORDER)
+        return nullptr;
+
+    Block *block = nullptr;
+    if (order == 0) {
+        bool enabled = Core::Interrupt::disable();
+        auto &hot = local[Core::getID()];
+        if (hot.count == 0) {
+            Locked locked(lock);
+            while (hot.count < BATCH) {
+                Block *page = take(0);
+                if (page == nullptr)
+                    break;
+                page->next = hot.pages;
+                hot.pages = page;
+                hot.count++;
+            }
+        }
+        if (hot.count > 0) {
+            block = hot.pages;
+            hot.pages = block->next;
+            hot.count--;
+        }
+        Core::Interrupt::restore(enabled);
+    } else {
+        {
+            Locked locked(lock);
+            block = take(order);
+        }
+        if (block == nullptr) {
+            // maybe a hot page completes a buddy
+            drain();
+            Locked locked(lock);
+            block = take(order);
+        }
+    }
+
+    __atomic_fetch_add(block != nullptr ? &statistics.allocations : &statistics.failures, 1, __ATOMIC_RELAXED);
+    return block;
+}
+
+void free(void *block, unsigned order) {
+    if (block == nullptr)
+        return;
+    assert(order <= MAX_ORDER);
+    size_t frame = frameOf(block);
+    assert(frame < frames && (frame & ((1UL << order) - 1)) == 0);
+    assert(state[frame] == order && "double free or wrong order");
+
+    if (order == 0) {
+        bool enabled = Core::Interrupt::disable();
+        auto &hot = local[Core::getID()];
+        Block *page = reinterpret_cast<Block *>(block);
+        page->next = hot.pages;
+        hot.pages = page;
+        if (++hot.count > HOT) {
+            Locked locked(lock);
+            while (hot.count > HOT - BATCH) {
+                page = hot.pages;
+                hot.pages = page->next;
+                hot.count--;
+                release(frameOf(page), 0);
+            }
+        }
+        Core::Interrupt::restore(enabled);
+    } else {
+        Locked locked(lock);
+        release(frame, order);
+    }
+}
+
+void drain() {
+    Locked locked(lock);
+    auto &hot = local[Core::getID()];
+    while (hot.pages != nullptr) {
+        Block *page = hot.pages;
+        hot.pages = page->next;
+        release(frameOf(page), 0);
+    }
+    hot.count = 0;
+}
+
+// Copy the statistics (with the lock held)
+static Stats collect() {
+    Stats s = statistics;
+    s.hot = 0;
+    for (const auto &hot : local)
+        s.hot += __atomic_load_n(&hot.count, __ATOMIC_RELAXED) * SIZE;
+    return s;
+}
+
+Stats stats() {
+    Locked locked(lock);
+    return collect();
+}
+
+bool tryStats(Stats &s) {
+    Locked locked(lock, false);
+    if (!locked.isHeld())
+        return false;
+    s = collect();
+    return true;
+}
+
+// Reserved ranges within the available memory
+static const unsigned RESERVED_MAX = 64;
+static struct {
+    uintptr_t from;
+    uintptr_t to;
+} reserved[RESERVED_MAX];
+static unsigned reserved_count = 0;
+
+static void reserve(uintptr_t from, uintptr_t to) {
+    from &= ~(SIZE - 1);
+    to = (to + SIZE - 1) & ~(SIZE - 1);
+    if (from >= to)
+        return;
+    if (reserved_count < RESERVED_MAX) {
+        reserved[reserved_count].from = from;
+        reserved[reserved_count].to = to;
+        reserved_count++;
+        return;
+    }
+    assert(false && "too many reserved ranges");
+    // Never hand out reserved memory: widen the closest range instead
+    unsigned closest = 0;
+    uintptr_t distance = ~0UL;
+    for (unsigned i = 0; i < RESERVED_MAX; i++) {
+        uintptr_t d = to < reserved[i].from ? reserved[i].from - to
+                    : reserved[i].to < from ? from - reserved[i].to : 0;
+        if (d < distance) {
+            distance = d;
+            closest = i;
+        }
+    }
+    if (from < reserved[closest].from)
+        reserved[closest].from = from;
+    if (to > reserved[closest].to)
+        reserved[closest].to = to;
+}
+
+// Call `visit` for all pages of [from, to) except for the reserved ranges
+template<typename F>
+static void available(uintptr_t from, uintptr_t to, F &visit) {
+    for (unsigned i = 0; i < reserved_count; i++) {
+        if (from < reserved[i].to && reserved[i].from < to) {
+            if (from < reserved[i].from)
+                available(from, reserved[i].from, visit);
+            if (reserved[i].to < to)
+                available(reserved[i].to, to, visit);
+            return;
+        }
+    }
+    visit(from, to);
+}
+
+// Call `visit` for all available (and not reserved) memory
+template<typename F>
+static void available(F visit) {
+    for (Multiboot::Memory *map = Multiboot::getMemoryMap(); map != nullptr; map = map->getNext()) {
+        if (!map->isAvailable())
+            continue;
+        uintptr_t from = (reinterpret_cast<uintptr_t>(map->getStartAddress()) + SIZE - 1) & ~(SIZE - 1);
+        uintptr_t to = reinterpret_cast<uintptr_t>(map->getEndAddress()) & ~(SIZE - 1);
+        if (from < BASE)
+            from = BASE;
+        if (to > LIMIT)
+            to = LIMIT;
+        if (from < to)
+            available(from, to, visit);
+    }
+}
+
+size_t init() {
+    reserve(reinterpret_cast<uintptr_t>(&___KERNEL_START___), reinterpret_cast<uintptr_t>(&___KERNEL_END___));
+    // the multiboot information is still read later on (e.g. by Graphics::init)
+    Multiboot::visitBootData(reserve);
+    Multiboot::Module *module;
+    for (unsigned i = 0; (module = Multiboot::getModule(i)) != nullptr; i++)
+        reserve(reinterpret_cast<uintptr_t>(module->getStartAddress()),
+                reinterpret_cast<uintptr_t>(module->getEndAddress()));
+
+    // Extent of the available memory
+    uintptr_t lowest = LIMIT;
+    uintptr_t highest = 0;
+    available([&](uintptr_t from, uintptr_t to) {
+        if (from < lowest)
+            lowest = from;
+        if (to > highest)
+            highest = to;
+    });
+    if (highest <= lowest)
+        return 0;
+    origin = lowest & ~((SIZE << MAX_ORDER) - 1);
+    frames = (highest - origin) / SIZE;
+
+    // Place the frame state in the first sufficient range
+    size_t bytes = frames * sizeof(*state);
+    available([&](uintptr_t from, uintptr_t to) {
+        if (state == nullptr && to - from >= bytes)
+            state = reinterpret_cast<uint8_t *>(from);
+    });
+    if (state == nullptr)
+        return 0;
+    for (size_t i = 0; i < frames; i++)
+        state[i] = 0;
+    reserve(reinterpret_cast<uintptr_t>(state), reinterpret_cast<uintptr_t>(state) + bytes);
+
+    // Release all remaining pages in blocks as large as their alignment permits
+    available([&](uintptr_t from, uintptr_t to) {
+        size_t frame = frameOf(reinterpret_cast<void *>(from));
+        size_t end = frameOf(reinterpret_cast<void *>(to));
+        while (frame < end) {
+            unsigned o = 0;
+            while (o < MAX_ORDER && (frame & ((2UL << o) - 1)) == 0 && frame + (2UL << o) <= end)
+                o++;
+            release(frame, o);
+            statistics.total += SIZE << o;
+            frame += 1UL << o;
+        }
+    });
+    return statistics.total;
+}
+
+}  // namespace PageFrame
@@ -0,0 +1,105 @@
+/*! \file
+ *  \brief \ref PageFrame "Page frame allocator" (buddy system)
+ */
+
+#pragma once
+
+#include "types.h"
+
+/*! \brief Allocator for physical page frames
+ *  \ingroup memory
+ *
+ * All memory reported as available by the
+ * \ref Multiboot::getMemoryMap "multiboot memory map" (within the identity
+ * mapped first 4 GiB) is managed here -- except for the first MiB, the kernel
+ * image, the boot modules (e.g. the initial ramdisk) and the information
+ * passed by the boot loader (see \ref Multiboot::visitBootData).
+ *
+ * Free memory is kept in naturally aligned blocks of 2^order pages, with one
+ * free list per order (*buddy system*): An allocation splits the smallest
+ * sufficient block in halves until it has the requested order; on release,
+ * a block is merged with its *buddy* (the other half of the next larger
+ * block) as long as the buddy is free as well. Hence large physically
+ * contiguous areas (up to 2^\ref MAX_ORDER pages) are available for buffers
+ * or huge pages. The state of each frame is kept in a byte array carved from
+ * the available memory itself.
+ *
+ * Single pages are the most frequent request (page tables, slabs, stacks);
+ * each core therefore keeps a list of *hot* pages (recently freed, probably
+ * still cached) which serves them without taking the global lock. Pages
+ * move between a hot list and the buddy system in batches.
+ *
+ * The allocator may be used by threads and epilogues on all cores, but not
+ * by prologues. The \ref Heap and the \ref SlabCache "slab caches" take
+ * their memory from here.
+ */
+namespace PageFrame {
+
+/// Size of a page frame
+const size_t SIZE = 4096;
+
+/// Largest block order (2^18 pages = 1 GiB)
+const unsigned MAX_ORDER = 18;
+
+/// Maximum number of hot pages per core
+const unsigned HOT = 64;
+
+/// Number of pages moved between hot lists and buddy system at once
+const unsigned BATCH = 16;
+
+/*! \brief Usage statistics
+ */
+struct Stats {
+	size_t total;    ///< Managed memory in bytes
+	size_t free;     ///< Bytes in free blocks of the buddy system
+	size_t hot;      ///< Bytes in the hot lists of all cores
+	uint64_t allocations;  ///< Number of successful allocations
+	uint64_t failures;     ///< Number of failed allocations
+	size_t blocks[MAX_ORDER + 1];  ///< Number of free blocks per order
+};
+
+/*! \brief Hand the available memory to the allocator
+ *
+ * \note Has to be called once on the bootstrap processor before any
+ *       allocation (including \ref malloc()).
+ * \return Number of bytes managed
+ */
+size_t init();
+
+/*! \brief Smallest order of a block holding at least `bytes`
+ */
+unsigned order(size_t bytes);
+
+/*! \brief Allocate a block of 2^order contiguous page frames
+ *
+ * \param order Block order (0 for a single page)
+ * \return Address of the block (aligned to its size) or `nullptr` if no
+ *         sufficient block is available
+ */
+void *allocate(unsigned order = 0);
+
+/*! \brief Return a block
+ *
+ * \param block Address returned by \ref allocate (or `nullptr`)
+ * \param order The order passed to \ref allocate
+ */
+void free(void *block, unsigned order = 0);
+
+/*! \brief Return the hot pages of the current core to the buddy system
+ *
+ * Useful before large allocations (or for accurate statistics).
+ */
+void drain();
+
+/*! \brief Retrieve the usage statistics
+ */
+Stats stats();
+
+/*! \brief Retrieve the usage statistics unless the allocator is locked
+ *
+ * \param s Receives the statistics
+ * \return `false` if the lock is held (see \ref Heap::tryStats)
+ */
+bool tryStats(Stats &s);
+
+}  // namespace PageFrame
@@ -0,0 +1,296 @@
+#include "memory/paging.h"
+#include "interrupt/remotecall.h"
+#include "machine/core.h"
+#include "machine/cpuid.h"
+#include "memory/pageframe.h"
+#include "sync/locked.h"
+#include "utils/string.h"
+
+extern "C" char ___KERNEL_START___;
+extern "C" char ___KERNEL_END___;
+
+namespace Paging {
+
+// Bits of a page table entry not covered by the public flags
+static const uint64_t PRESENT = 1ULL << 0;
+static const uint64_t PAGE_SIZE = 1ULL << 7;
+static const uint64_t PAT_LARGE = 1ULL << 12;
+static const uint64_t ADDRESS = 0x000ffffffffff000ULL;
+// Flags at the same position in all leaf entries
+static const uint64_t ATTRIBUTES = WRITEABLE | USER | WRITE_THROUGH | CACHE_DISABLE | GLOBAL | NO_EXECUTE;
+
+// Memory types in the PAT: power-on default, but entry 4 is write-combining
+static const uint64_t PAT_WB = 0x06;
+static const uint64_t PAT_WT = 0x04;
+static const uint64_t PAT_UC_MINUS = 0x07;
+static const uint64_t PAT_UC = 0x00;
+static const uint64_t PAT_WC = 0x01;
+static const uint64_t PAT = PAT_WB | PAT_WT << 8 | PAT_UC_MINUS << 16 | PAT_UC << 24 |
+                            PAT_WC << 32 | PAT_WT << 40 | PAT_UC_MINUS << 48 | PAT_UC << 56;
+
+// Intermediate entries are permissive, the leaf decides (like in boot/longmode.asm)
+static const uint64_t TABLE = PRESENT | WRITEABLE | USER;
+
+static const unsigned ENTRIES = 512;
+// Offset bits of an entry in the level 4 table
+static const unsigned TOP = 39;
+
+// Flags the CPU accepts (e.g. the no-execute bit is reserved unless enabled)
+static uint64_t supported = ATTRIBUTES & ~NO_EXECUTE;
+
+static Ticketlock lock{"Paging"};
+
+namespace {
+struct Range {
+    uintptr_t from;
+    uintptr_t to;
+};
+}  // namespace
+
+static uint64_t *root() {
+    return reinterpret_cast<uint64_t *>(Core::CR<3>::read() & ADDRESS);
+}
+
+static unsigned index(uintptr_t virt, unsigned shift) {
+    return (virt >> shift) % ENTRIES;
+}
+
+// Page tables are identity mapped
+static uint64_t *tableOf(uint64_t entry) {
+    return reinterpret_cast<uint64_t *>(entry & ADDRESS);
+}
+
+// Leaf entry bits for the flags
+static uint64_t encode(uint64_t flags, bool large) {
+    uint64_t bits = flags & ATTRIBUTES;
+    if ((flags & WRITE_COMBINING) != 0)
+        bits |= large ? PAT_LARGE : WRITE_COMBINING;
+    return bits;
+}
+
+// Flags of a leaf entry
+static Flags decode(uint64_t entry, bool large) {
+    uint64_t flags = entry & ATTRIBUTES;
+    if ((entry & (large ? PAT_LARGE : WRITE_COMBINING)) != 0)
+        flags |= WRITE_COMBINING;
+    return static_cast<Flags>(flags);
+}
+
+static uint64_t *allocateTable() {
+    void *table = PageFrame::allocate();
+    if (table != nullptr)
+        memset(table, 0, PageFrame::SIZE);
+    return reinterpret_cast<uint64_t *>(table);
+}
+
+// Executed on each core
+static void invalidate(void *arg) {
+    const Range *range = reinterpret_cast<const Range *>(arg);
+    if ((range->to - range->from) / PageFrame::SIZE <= Batch::PAGES) {
+        for (uintptr_t address = range->from; address < range->to; address += PageFrame::SIZE)
+            asm volatile("invlpg (%0)" : : "r"(address) : "memory");
+    } else {
+        uintptr_t cr4 = Core::CR<4>::read();
+        if ((cr4 & Core::CR4_PGE) != 0) {
+            // toggling the global pages flushes all entries (including global ones)
+            Core::CR<4>::write(cr4 & ~Core::CR4_PGE);
+            Core::CR<4>::write(cr4);
+        } else {
+            Core::CR<3>::write(Core::CR<3>::read());
+        }
+    }
+}
+
+void Batch::add(uintptr_t address, size_t size) {
+    if (address < from)
+        from = address;
+    if (address + size > to)
+        to = address + size;
+}
+
+void Batch::retire(void *table) {
+    // the boot page tables are part of the kernel image
+    if (table >= &___KERNEL_START___ && table < &___KERNEL_END___)
+        return;
+    // a page aligned link in the first entry looks like a not present entry
+    *reinterpret_cast<void **>(table) = retired;
+    retired = table;
+}
+
+void Batch::flush() {
+    if (from < to) {
+        Range range{from, to};
+        RemoteCall::callOnAll(invalidate, &range);
+        from = ~0UL;
+        to = 0;
+    }
+    while (retired != nullptr) {
+        void *table = retired;
+        retired = *reinterpret_cast<void **>(table);
+        PageFrame::free(table);
+    }
+}
+
+// Retire `table` (with entries of 2^shift bytes) including all its subtables
+static void retire(uint64_t *table, unsigned shift, Batch &batch) {
+    if (shift > SIZE_4K)
+        for (unsigned i = 0; i < ENTRIES; i++)
+            if ((table[i] & PRESENT) != 0 && (table[i] & PAGE_SIZE) == 0)
+                retire(tableOf(table[i]), shift - 9, batch);
+    batch.retire(table);
+}
+
+// Replace the large page `entry` (of 2^shift bytes) by a table of smaller pages
+static bool split(uint64_t &entry, unsigned shift, uintptr_t virt, Batch &batch) {
+    uint64_t *table = allocateTable();
+    if (table == nullptr)
+        return false;
+    unsigned child = shift - 9;
+    uint64_t base = entry & ADDRESS & ~((1ULL << shift) - 1);
+    uint64_t leaf = PRESENT | encode(decode(entry, true), child != SIZE_4K);
+    if (child != SIZE_4K)
+        leaf |= PAGE_SIZE;
+    for (unsigned i = 0; i < ENTRIES; i++)
+        table[i] = (base + (static_cast<uint64_t>(i) << child)) | leaf;
+    entry = reinterpret_cast<uintptr_t>(table) | TABLE;
+    batch.add(virt & ~((1ULL << shift) - 1), 1ULL << shift);
+    return true;
+}
+
+// Entry for `virt` in the table with entries of 2^target bytes (created if necessary)
+static uint64_t *walk(uintptr_t virt, unsigned target, Batch &batch) {
+    uint64_t *table = root();
+    for (unsigned shift = TOP; shift > target; shift -= 9) {
+        uint64_t &entry = table[index(virt, shift)];
+        if ((entry & PRESENT) == 0) {
+            uint64_t *next = allocateTable();
+            if (next == nullptr)
+                return nullptr;
+            entry = reinterpret_cast<uintptr_t>(next) | TABLE;
+        } else if ((entry & PAGE_SIZE) != 0 && !split(entry, shift, virt, batch)) {
+            return nullptr;
+        }
+        table = tableOf(entry);
+    }
+    return &table[index(virt, target)];
+}
+
+// Remove or change the leaf entries in [virt, virt + size), splitting partially covered pages
+static bool update(uintptr_t virt, size_t size, bool remove, uint64_t flags, Batch &batch) {
+    uintptr_t end = virt + size;
+    while (virt < end) {
+        uint64_t *table = root();
+        for (unsigned shift = TOP; ; shift -= 9) {
+            uint64_t &entry = table[index(virt, shift)];
+            uintptr_t span = 1ULL << shift;
+            uintptr_t next = (virt & ~(span - 1)) + span;
+            if ((entry & PRESENT) == 0) {
+                virt = next;
+                break;
+            }
+            if (shift == SIZE_4K || (entry & PAGE_SIZE) != 0) {
+                if ((virt & (span - 1)) == 0 && next <= end) {
+                    bool large = shift != SIZE_4K;
+                    uint64_t keep = ~(ATTRIBUTES | (large ? PAT_LARGE : WRITE_COMBINING));
+                    entry = remove ? 0 : (entry & keep) | encode(flags, large);
+                    batch.add(virt, span);
+                    virt = next;
+                    break;
+                }
+                if (!split(entry, shift, virt, batch))
+                    return false;
+            }
+            table = tableOf(entry);
+        }
+    }
+    return true;
+}
+
+void init() {
+    if (CPUID::has(CPUID::EXTENDED_FEATURE_NX)) {
+        Core::MSR<Core::MSR_EFER>::write(Core::MSR<Core::MSR_EFER>::read() | Core::MSR_EFER_NXE);
+        supported |= NO_EXECUTE;
+    }
+    if (CPUID::has(CPUID::FEATURE_PGE))
+        Core::CR<4>::write(Core::CR<4>::read() | Core::CR4_PGE);
+    // No entry selects PAT entry 4 before, so it can be changed right away
+    if (CPUID::has(CPUID::FEATURE_PAT)) {
+        Core::MSR<Core::MSR_PAT>::write(PAT);
+        supported |= WRITE_COMBINING;
+    }
+}
+
+bool supports(Size size) {
+    switch (size) {
+        case SIZE_4K:
+        case SIZE_2M:
+            return true;
+        case SIZE_1G:
+            return CPUID::has(CPUID::EXTENDED_FEATURE_PDPE1GB);
+        default:
+            return false;
+    }
+}
+
+bool map(uintptr_t virt, uintptr_t phys, size_t size, Size page, Flags flags, Batch *batch) {
+    uint64_t step = 1ULL << page;
+    if (((virt | phys | size) & (step - 1)) != 0 || !supports(page))
+        return false;
+
+    Batch local;
+    Batch &b = batch != nullptr ? *batch : local;
+    Locked locked(lock);
+    for (uint64_t offset = 0; offset < size; offset += step) {
+        uint64_t *entry = walk(virt + offset, page, b);
+        if (entry == nullptr)
+            return false;
+        if ((*entry & PRESENT) != 0) {
+            if (page != SIZE_4K && (*entry & PAGE_SIZE) == 0)
+                retire(tableOf(*entry), page - 9, b);
+            b.add(virt + offset, step);
+        }
+        *entry = (phys + offset) | PRESENT | (page != SIZE_4K ? PAGE_SIZE : 0) | encode(flags & supported, page != SIZE_4K);
+    }
+    return true;
+}
+
+bool unmap(uintptr_t virt, size_t size, Batch *batch) {
+    if (((virt | size) & (PageFrame::SIZE - 1)) != 0)
+        return false;
+    Batch local;
+    Batch &b = batch != nullptr ? *batch : local;
+    Locked locked(lock);
+    return update(virt, size, true, 0, b);
+}
+
+bool protect(uintptr_t virt, size_t size, Flags flags, Batch *batch) {
+    if (((virt | size) & (PageFrame::SIZE - 1)) != 0)
+        return false;
+    Batch local;
+    Batch &b = batch != nullptr ? *batch : local;
+    Locked locked(lock);
+    return update(virt, size, false, flags & supported, b);
+}
+
+bool translate(uintptr_t virt, uintptr_t *phys, Size *page, Flags *flags) {
+    Locked locked(lock);
+    uint64_t *table = root();
+    for (unsigned shift = TOP; ; shift -= 9) {
+        uint64_t entry = table[index(virt, shift)];
+        if ((entry & PRESENT) == 0)
+            return false;
+        if (shift == SIZE_4K || (entry & PAGE_SIZE) != 0) {
+            uint64_t mask = (1ULL << shift) - 1;
+            if (phys != nullptr)
+                *phys = (entry & ADDRESS & ~mask) | (virt & mask);
+            if (page != nullptr)
+                *page = static_cast<Size>(shift);
+            if (flags != nullptr)
+                *flags = decode(entry, shift != SIZE_4K);
+            return true;
+        }
+        table = tableOf(entry);
+    }
+}
+
+}  // namespace Paging
@@ -0,0 +1,177 @@
+/*! \file
+ *  \brief \ref Paging "Kernel address space" with 4 KiB, 2 MiB and 1 GiB pages
+ */
+
+#pragma once
+
+#include "types.h"
+
+/*! \brief Manipulation of the kernel address space
+ *  \ingroup memory
+ *
+ * At boot, `boot/longmode.asm` identity maps the first 4 GiB with 2 MiB pages.
+ * These (four-level) page tables are shared by all cores; this interface
+ * allows to change them at runtime: \ref map a range with a selected page
+ * size and attributes (e.g. uncached MMIO), \ref unmap it (e.g. for guard
+ * pages) or \ref protect it with other attributes. Larger pages are split
+ * automatically if only a part of them is affected. Page tables are taken
+ * from the \ref PageFrame "page frame allocator".
+ *
+ * Each modification of an existing entry has to be followed by the
+ * invalidation of the corresponding TLB entries -- on every core. Instead
+ * of flushing after each entry, the affected range is collected in a
+ * \ref Batch, which is flushed once: locally with `invlpg` for a few pages
+ * (or by reloading `cr3` for larger ranges) and on the other cores with a
+ * single \ref RemoteCall. Several operations can share a batch:
+ *
+ * \code{.cpp}
+ *  Paging::Batch batch;
+ *  Paging::unmap(guard, 4096, &batch);
+ *  Paging::map(lfb, lfb, size, Paging::SIZE_2M, Paging::WRITEABLE | Paging::WRITE_THROUGH, &batch);
+ *  batch.flush();  // or leave the scope
+ * \endcode
+ *
+ * All functions may be called by threads and epilogues (but not prologues)
+ * on all cores; modifications are serialized by a \ref Ticketlock.
+ * Flushing a batch waits until every online core has executed the remote
+ * call: This is possible while holding the \ref Guard (cores waiting for it
+ * in \ref Guard::enter serve remote calls), but not while holding any other
+ * lock a core might spin on with interrupts disabled.
+ *
+ * The memory type of a page is selected by the bits `PAT`, `PCD` and `PWT`
+ * of its entry, indexing the *Page Attribute Table*. \ref init programs the
+ * otherwise unused entry 4 (only the `PAT` bit set) as write-combining, so
+ * \ref WRITE_COMBINING stands for this bit -- which is located in bit 7 of
+ * 4 KiB entries but in bit 12 of larger ones (bit 7 marks them as pages).
+ *
+ * \see [ISDMv3, 11.12 Page Attribute Table](intel_manual_vol3.pdf#page=467)
+ */
+namespace Paging {
+
+/*! \brief Supported page sizes (value is the number of offset bits)
+ */
+enum Size : uint8_t {
+	SIZE_4K = 12,  ///< 4 KiB page
+	SIZE_2M = 21,  ///< 2 MiB page
+	SIZE_1G = 30,  ///< 1 GiB page (only if the CPU supports it)
+};
+
+/*! \brief Attributes of a mapping (bits of the page table entry)
+ */
+enum Flags : uint64_t {
+	NONE            = 0,           ///< Read only, kernel only, write back
+	WRITEABLE       = 1ULL << 1,   ///< Writes are allowed
+	USER            = 1ULL << 2,   ///< Accessible in user mode
+	WRITE_THROUGH   = 1ULL << 3,   ///< Write-through caching
+	CACHE_DISABLE   = 1ULL << 4,   ///< Uncached (e.g. for MMIO registers)
+	WRITE_COMBINING = 1ULL << 7,   ///< Write-combining, e.g. for frame buffers (ignored without PAT)
+	GLOBAL          = 1ULL << 8,   ///< Not flushed when reloading `cr3` (requires `CR4.PGE`)
+	NO_EXECUTE      = 1ULL << 63,  ///< Instruction fetches are not allowed (ignored if not supported)
+};
+
+/// Combine flags
+constexpr Flags operator|(Flags a, Flags b) {
+	return static_cast<Flags>(static_cast<uint64_t>(a) | static_cast<uint64_t>(b));
+}
+
+/*! \brief Pending TLB invalidations
+ *
+ * Collects the virtual range affected by modifications and invalidates it on
+ * all cores at once -- explicitly by calling \ref flush or when leaving the
+ * scope. Page tables which became unused are only released after the flush.
+ */
+class Batch {
+	// Prevent copies and assignments
+	Batch(const Batch&)            = delete;
+	Batch& operator=(const Batch&) = delete;
+
+ public:
+	/// Up to this number of pages, the entries are invalidated one by one
+	static const unsigned PAGES = 32;
+
+ private:
+	uintptr_t from;
+	uintptr_t to;
+	// Page tables to be released (linked through their first entry)
+	void *retired;
+
+ public:
+	Batch() : from(~0UL), to(0), retired(nullptr) {}
+
+	~Batch() {
+		flush();
+	}
+
+	/*! \brief Add a modified range
+	 */
+	void add(uintptr_t address, size_t size);
+
+	/*! \brief Release a page table (which is no longer referenced) after
+	 * the next flush
+	 */
+	void retire(void *table);
+
+	/*! \brief Invalidate the collected range on all online cores
+	 */
+	void flush();
+};
+
+/*! \brief Prepare the paging (e.g. enable the no-execute bit and program
+ * the PAT)
+ *
+ * \note Has to be called on each core.
+ */
+void init();
+
+/*! \brief Check if a page size is supported by the CPU
+ */
+bool supports(Size size);
+
+/*! \brief Map a range of physical memory
+ *
+ * Existing mappings in the range are replaced.
+ *
+ * \param virt Virtual address (aligned to the page size)
+ * \param phys Physical address (aligned to the page size)
+ * \param size Size of the range (multiple of the page size)
+ * \param page Page size used for the mapping
+ * \param flags Attributes of the mapping
+ * \param batch Collects the TLB invalidations (flushed right away if `nullptr`)
+ * \return `false` if the arguments are invalid or no page table could be
+ *         allocated (the range may then be partially mapped)
+ */
+bool map(uintptr_t virt, uintptr_t phys, size_t size, Size page = SIZE_4K, Flags flags = WRITEABLE,
+         Batch *batch = nullptr);
+
+/*! \brief Remove the mappings of a range
+ *
+ * \param virt Virtual address (page aligned)
+ * \param size Size of the range (multiple of 4 KiB)
+ * \param batch Collects the TLB invalidations (flushed right away if `nullptr`)
+ * \return `false` if a larger page could not be split
+ */
+bool unmap(uintptr_t virt, size_t size, Batch *batch = nullptr);
+
+/*! \brief Change the attributes of the mapped pages in a range
+ *
+ * Pages which are not mapped are skipped.
+ *
+ * \param virt Virtual address (page aligned)
+ * \param size Size of the range (multiple of 4 KiB)
+ * \param flags New attributes
+ * \param batch Collects the TLB invalidations (flushed right away if `nullptr`)
+ * \return `false` if a larger page could not be split
+ */
+bool protect(uintptr_t virt, size_t size, Flags flags, Batch *batch = nullptr);
+
+/*! \brief Look up the mapping of a virtual address
+ *
+ * \param virt Virtual address
+ * \param phys Receives the physical address (if not `nullptr`)
+ * \param page Receives the size of the page (if not `nullptr`)
+ * \param flags Receives the attributes of the page (if not `nullptr`)
+ * \return `true` if the address is mapped
+ */
+bool translate(uintptr_t virt, uintptr_t *phys = nullptr, Size *page = nullptr, Flags *flags = nullptr);
+
+}  // namespace Paging
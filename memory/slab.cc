@@ -0,0 +1,281 @@
+#include "memory/slab.h"
+#include "debug/assert.h"
+#include "memory/pageframe.h"
+#include "sync/locked.h"
+#include "utils/alloc.h"
+
+struct SlabCache::Slab {
+    SlabCache *cache;
+    Slab *next;
+    Slab *prev;
+    // Free objects (linked through their first word)
+    void *free;
+    unsigned inuse;
+};
+
+struct SlabCache::Magazine {
+    Magazine *next;
+    unsigned rounds;
+    void *round[ROUNDS];
+};
+
+SlabCache *SlabCache::first = nullptr;
+
+// Distance between two colours
+static size_t colourStep(size_t align) {
+    return align > CACHE_LINE_SIZE ? align : CACHE_LINE_SIZE;
+}
+
+SlabCache::SlabCache(const char *name, size_t size, size_t align) : local(), name(name), lock(name),
+    full(nullptr), partial(nullptr), empty(nullptr), count_full(0), count_partial(0), count_empty(0),
+    used(0), grown(0), reaped(0), depot_full(nullptr), depot_empty(nullptr) {
+    assert((align & (align - 1)) == 0);
+    if (align < sizeof(void *))
+        align = sizeof(void *);
+    this->align = align;
+    // objects have to hold the free list link
+    if (size < sizeof(void *))
+        size = sizeof(void *);
+    this->size = (size + align - 1) & ~(align - 1);
+    offset = (sizeof(Slab) + align - 1) & ~(align - 1);
+    slab_size = SLAB_MIN;
+    while ((slab_size - offset) / this->size < SLAB_OBJECTS)
+        slab_size *= 2;
+    slab_order = PageFrame::order(slab_size);
+    objects = (slab_size - offset) / this->size;
+    colours = (slab_size - offset - objects * this->size) / colourStep(align) + 1;
+    colour = 0;
+
+    // register
+    next = __atomic_load_n(&first, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&first, &next, this, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {}
+}
+
+namespace {
+template<typename T>
+void push(T *&list, T *item) {
+    item->prev = nullptr;
+    item->next = list;
+    if (list != nullptr)
+        list->prev = item;
+    list = item;
+}
+
+template<typename T>
+void remove(T *&list, T *item) {
+    if (item->prev != nullptr)
+        item->prev->next = item->next;
+    else
+        list = item->next;
+    if (item->next != nullptr)
+        item->next->prev = item->prev;
+}
+}  // namespace
+
+SlabCache::Slab *SlabCache::grow() {
+    void *memory = PageFrame::allocate(slab_order);
+    if (memory == nullptr)
+        return nullptr;
+    Slab *slab = reinterpret_cast<Slab *>(memory);
+    slab->cache = this;
+    slab->inuse = 0;
+    slab->free = nullptr;
+    // colouring: shift the objects of each new slab by another step
+    char *base = reinterpret_cast<char *>(memory) + offset + colour * colourStep(align);
+    colour = (colour + 1) % colours;
+    for (unsigned i = objects; i > 0; i--) {
+        void **object = reinterpret_cast<void **>(base + (i - 1) * size);
+        *object = slab->free;
+        slab->free = object;
+    }
+    push(empty, slab);
+    count_empty++;
+    grown++;
+    return slab;
+}
+
+void *SlabCache::take() {
+    Slab *slab = partial;
+    if (slab == nullptr) {
+        slab = empty != nullptr ? empty : grow();
+        if (slab == nullptr)
+            return nullptr;
+        remove(empty, slab);
+        count_empty--;
+        push(partial, slab);
+        count_partial++;
+    }
+    void **object = reinterpret_cast<void **>(slab->free);
+    slab->free = *object;
+    if (++slab->inuse == objects) {
+        remove(partial, slab);
+        count_partial--;
+        push(full, slab);
+        count_full++;
+    }
+    used++;
+    return object;
+}
+
+void SlabCache::put(void *object) {
+    Slab *slab = reinterpret_cast<Slab *>(reinterpret_cast<uintptr_t>(object) & ~(slab_size - 1));
+    assert(slab->cache == this && "object does not belong to this cache");
+    *reinterpret_cast<void **>(object) = slab->free;
+    slab->free = object;
+    if (slab->inuse-- == objects) {
+        remove(full, slab);
+        count_full--;
+        push(partial, slab);
+        count_partial++;
+    }
+    if (slab->inuse == 0) {
+        remove(partial, slab);
+        count_partial--;
+        // keep a single empty slab to avoid thrashing
+        if (count_empty > 0) {
+            PageFrame::free(slab, slab_order);
+            reaped++;
+        } else {
+            push(empty, slab);
+            count_empty++;
+        }
+    }
+    used--;
+}
+
+void *SlabCache::allocate() {
+    bool enabled = Core::Interrupt::disable();
+    Local &l = local[Core::getID()];
+    l.allocations++;
+    if (l.loaded == nullptr || l.loaded->rounds == 0) {
+        if (l.previous != nullptr && l.previous->rounds > 0) {
+            Magazine *m = l.loaded;
+            l.loaded = l.previous;
+            l.previous = m;
+        } else {
+            lock.lock();
+            Magazine *m = depot_full;
+            if (m == nullptr) {
+                // no full magazine available -- use the slab layer
+                void *object = take();
+                lock.unlock();
+                Core::Interrupt::restore(enabled);
+                return object;
+            }
+            depot_full = m->next;
+            if (l.previous != nullptr) {
+                l.previous->next = depot_empty;
+                depot_empty = l.previous;
+            }
+            lock.unlock();
+            l.previous = l.loaded;
+            l.loaded = m;
+        }
+    }
+    l.hits++;
+    void *object = l.loaded->round[--l.loaded->rounds];
+    Core::Interrupt::restore(enabled);
+    return object;
+}
+
+void SlabCache::deallocate(void *object) {
+    if (object == nullptr)
+        return;
+    bool enabled = Core::Interrupt::disable();
+    Local &l = local[Core::getID()];
+    if (l.loaded == nullptr || l.loaded->rounds == ROUNDS) {
+        if (l.previous != nullptr && l.previous->rounds < ROUNDS) {
+            Magazine *m = l.loaded;
+            l.loaded = l.previous;
+            l.previous = m;
+        } else {
+            lock.lock();
+            Magazine *m = depot_empty;
+            if (m != nullptr)
+                depot_empty = m->next;
+            lock.unlock();
+            if (m == nullptr) {
+                m = reinterpret_cast<Magazine *>(malloc(sizeof(Magazine)));
+                if (m == nullptr) {
+                    // no magazine available -- use the slab layer
+                    lock.lock();
+                    put(object);
+                    lock.unlock();
+                    Core::Interrupt::restore(enabled);
+                    return;
+                }
+                m->rounds = 0;
+            }
+            if (l.previous != nullptr) {
+                lock.lock();
+                l.previous->next = depot_full;
+                depot_full = l.previous;
+                lock.unlock();
+            }
+            l.previous = l.loaded;
+            l.loaded = m;
+        }
+    }
+    l.loaded->round[l.loaded->rounds++] = object;
+    Core::Interrupt::restore(enabled);
+}
+
+void SlabCache::reap() {
+    bool enabled = Core::Interrupt::disable();
+    lock.lock();
+    // return the objects of the full magazines in the depot
+    while (depot_full != nullptr) {
+        Magazine *m = depot_full;
+        depot_full = m->next;
+        while (m->rounds > 0)
+            put(m->round[--m->rounds]);
+        free(m);
+    }
+    while (depot_empty != nullptr) {
+        Magazine *m = depot_empty;
+        depot_empty = m->next;
+        free(m);
+    }
+    while (empty != nullptr) {
+        Slab *slab = empty;
+        remove(empty, slab);
+        count_empty--;
+        PageFrame::free(slab, slab_order);
+        reaped++;
+    }
+    lock.unlock();
+    Core::Interrupt::restore(enabled);
+}
+
+void SlabCache::collect(Stats &s) const {
+    s.size = size;
+    s.slab = slab_size;
+    s.objects = objects;
+    s.full = count_full;
+    s.partial = count_partial;
+    s.empty = count_empty;
+    s.used = used;
+    s.grown = grown;
+    s.reaped = reaped;
+    s.allocations = 0;
+    s.hits = 0;
+    for (const Local &l : local) {
+        s.allocations += l.allocations;
+        s.hits += l.hits;
+    }
+}
+
+SlabCache::Stats SlabCache::stats() {
+    Stats s;
+    Locked locked(lock);
+    collect(s);
+    return s;
+}
+
+bool SlabCache::tryStats(Stats &s) {
+    Locked locked(lock, false);
+    if (!locked.isHeld())
+        return false;
+    collect(s);
+    return true;
+}
@@ -0,0 +1,177 @@
+/*! \file
+ *  \brief \ref SlabCache "Slab allocator" for fixed-size objects
+ */
+
+#pragma once
+
+#include "types.h"
+#include "machine/cache.h"
+#include "machine/core.h"
+#include "sync/ticketlock.h"
+
+/*! \brief Object cache with per-core magazines (following Bonwick)
+ *  \ingroup memory
+ *
+ * A cache hands out objects of a single size. They are carved from *slabs*
+ * -- naturally aligned blocks of (at least) 4 KiB taken from the
+ * \ref PageFrame "page frame allocator", with a small header at the
+ * beginning. Each slab keeps a free list of its
+ * objects and moves between the cache's lists of full, partial and empty
+ * slabs. Successive slabs shift their first object by another cache line
+ * (*colouring*), so that objects at the same index do not compete for the
+ * same cache sets.
+ *
+ * On top of the slab layer, each core owns two *magazines* (stacks of up to
+ * \ref ROUNDS objects): \ref allocate and \ref deallocate usually only
+ * push or pop a round with interrupts disabled -- without any lock and
+ * without touching shared cache lines. Only when both magazines of a core
+ * are empty (or full), a magazine is exchanged with the cache's depot, and
+ * only if the depot cannot help either, the slab layer is accessed.
+ * Both depot and slab layer are protected by a \ref Ticketlock.
+ *
+ * All caches are registered in a list (see \ref getFirst) for reports.
+ *
+ * \note Caches may be global objects: They do not allocate anything before
+ *       the first call of \ref allocate.
+ */
+class SlabCache {
+	// Prevent copies and assignments
+	SlabCache(const SlabCache&)            = delete;
+	SlabCache& operator=(const SlabCache&) = delete;
+
+ public:
+	/// Capacity of a magazine
+	static const unsigned ROUNDS = 15;
+
+	/// Minimum size of a slab
+	static const size_t SLAB_MIN = 4096;
+
+	/// Minimum number of objects per slab
+	static const unsigned SLAB_OBJECTS = 8;
+
+	/*! \brief Statistics of a cache
+	 */
+	struct Stats {
+		size_t size;             ///< Object size (including padding)
+		size_t slab;             ///< Slab size
+		unsigned objects;        ///< Objects per slab
+		unsigned full;           ///< Number of full slabs
+		unsigned partial;        ///< Number of partially used slabs
+		unsigned empty;          ///< Number of empty slabs
+		size_t used;             ///< Objects in slabs which are handed out or in magazines
+		uint64_t allocations;    ///< Calls to \ref allocate
+		uint64_t hits;           ///< \ref allocate calls served by a local magazine
+		uint64_t grown;          ///< Slabs taken from the page frame allocator
+		uint64_t reaped;         ///< Slabs returned to the page frame allocator
+	};
+
+ private:
+	struct Slab;
+	struct Magazine;
+
+	/// Core local magazines
+	struct cache_aligned Local {
+		Magazine *loaded;
+		Magazine *previous;
+		uint64_t allocations;
+		uint64_t hits;
+	} local[Core::MAX];
+
+	/// All caches (linked by `next`)
+	static SlabCache *first;
+	SlabCache *next;
+
+	const char *name;
+	size_t size;
+	size_t align;
+	size_t slab_size;
+	unsigned slab_order;
+	size_t offset;
+	unsigned objects;
+	unsigned colours;
+	unsigned colour;
+
+	Ticketlock lock;
+
+	// Slab layer (protected by lock)
+	Slab *full;
+	Slab *partial;
+	Slab *empty;
+	unsigned count_full;
+	unsigned count_partial;
+	unsigned count_empty;
+	size_t used;
+	uint64_t grown;
+	uint64_t reaped;
+
+	// Depot (protected by lock)
+	Magazine *depot_full;
+	Magazine *depot_empty;
+
+	Slab *grow();
+	void *take();
+	void put(void *object);
+	void collect(Stats &s) const;
+
+ public:
+	/*! \brief Constructor
+	 *
+	 * \param name Name shown in the statistics
+	 * \param size Object size in bytes
+	 * \param align Object alignment (a power of two)
+	 */
+	SlabCache(const char *name, size_t size, size_t align = 16);
+
+	/*! \brief Allocate an object
+	 * \return Pointer to the uninitialized object or `nullptr` if no memory
+	 *         is available
+	 */
+	void *allocate();
+
+	/*! \brief Return an object to the cache
+	 * \param object Object previously allocated from this cache (or `nullptr`)
+	 */
+	void deallocate(void *object);
+
+	/*! \brief Return all empty slabs to the page frame allocator
+	 *
+	 * The magazines in the depot are flushed first; objects held in the
+	 * magazines of the cores are not affected.
+	 */
+	void reap();
+
+	/*! \brief Retrieve the statistics
+	 */
+	Stats stats();
+
+	/*! \brief Retrieve the statistics unless the cache is locked
+	 *
+	 * \param s Receives the statistics
+	 * \return `false` if the lock is held (see \ref Heap::tryStats)
+	 */
+	bool tryStats(Stats &s);
+
+	/*! \brief Name of the cache
+	 */
+	const char *getName() const {
+		return name;
+	}
+
+	/*! \brief Object size of the cache
+	 */
+	size_t getSize() const {
+		return size;
+	}
+
+	/*! \brief First registered cache (for iteration)
+	 */
+	static SlabCache *getFirst() {
+		return __atomic_load_n(&first, __ATOMIC_ACQUIRE);
+	}
+
+	/*! \brief Next registered cache (or `nullptr`)
+	 */
+	SlabCache *getNext() const {
+		return next;
+	}
+};
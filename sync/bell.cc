@@ -1,10 +1,13 @@
 #include "sync/bell.h"
 #include "sync/bellringer.h"
+#include "machine/tsc.h"
 #include "thread/scheduler.h"
 
 void Bell::ring() {
-    for (Thread* thread = dequeue(); thread != nullptr; thread = dequeue())
-        Scheduler::wakeup(thread);
+    unsigned woken = 0;
+    for (Thread* thread = dequeue(); thread != nullptr; thread = dequeue(), woken++)
+        Scheduler::wakeup(thread, false);
+    Scheduler::notify(woken);
 }
 
 void Bell::sleep(unsigned int ms) {
@@ -14,3 +17,11 @@ void Bell::sleep(unsigned int ms) {
     Bellringer::job(&bell, ms);
     Scheduler::block(&bell);
 }
+
+void Bell::usleep(unsigned int us) {
+    if (us == 0)
+        return;
+    Bell bell{us / 1000};
+    Bellringer::jobAt(&bell, TSC::read() + TSC::fromMicroseconds(us));
+    Scheduler::block(&bell);
+}
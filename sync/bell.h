@@ -4,6 +4,7 @@
  *  \brief \ref Bell, a synchronization object for sleeping
  */
 
+#include "types.h"
 #include "sync/waitingroom.h"
 #include "object/queue.h"
 
@@ -23,11 +24,14 @@ class Bell : public Waitingroom, public Queue<Bell>::Node {
  public:
 	unsigned int ms;
 
+	/// Absolute time (in TSC ticks) at which the \ref Bellringer rings the bell
+	uint64_t deadline;
+
 	/*! \brief Constructor
 	 *
 	 *  Constructs a new bell; the newly created bell is, at first, disabled.
 	 */
-	explicit Bell(unsigned int ms) : ms(ms) {}
+	explicit Bell(unsigned int ms) : ms(ms), deadline(0) {}
 
 	/*! \brief Ring the bell
 	 *
@@ -43,4 +47,14 @@ class Bell : public Waitingroom, public Queue<Bell>::Node {
 	 *  \todo Implement Method
 	 */
 	static void sleep(unsigned int ms);
+
+	/*! \brief Creates a temporary bell object and sleeps for the given
+	 *  timespan with microsecond resolution
+	 *
+	 *  The resolution depends on the \ref Watch: In TSC-deadline mode, the
+	 *  thread is woken up right on time, otherwise on the next timer tick.
+	 *
+	 *  \param us time in microseconds
+	 */
+	static void usleep(unsigned int us);
 };
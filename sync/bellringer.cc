@@ -1,50 +1,48 @@
 #include "sync/bellringer.h"
+#include "device/watch.h"
+#include "machine/tsc.h"
 
 Queue<Bell> Bellringer::queue{};
 
 void Bellringer::check() {
     if (queue.first() == nullptr)
         return;
-    queue.first()->ms--;
-    while (queue.first() != nullptr && queue.first()->ms == 0)
+    uint64_t now = TSC::read();
+    while (queue.first() != nullptr && queue.first()->deadline <= now)
         queue.dequeue()->ring();
 }
 
 void Bellringer::job(Bell *bell, unsigned int ms) {
-    if (queue.first() == nullptr)
-        return queue.insertFirst(bell);
-    Queue<Bell>::Iterator iterator = queue.begin();
-    if (ms < queue.first()->ms) {
+    jobAt(bell, TSC::read() + TSC::fromMicroseconds(static_cast<uint64_t>(ms) * 1000));
+}
+
+void Bellringer::jobAt(Bell *bell, uint64_t deadline) {
+    bell->deadline = deadline;
+    Bell *first = queue.first();
+    if (first == nullptr || deadline < first->deadline) {
         queue.insertFirst(bell);
-        (*iterator)->ms -= ms;
+        watch.alarm(deadline);
         return;
     }
-    Queue<Bell>::Iterator before = queue.begin();
-    while (iterator != queue.end()) {
-        if ((*iterator)->ms < ms) {
-            ms -= (*iterator)->ms;
-            before = iterator;
-            ++iterator;
-        } else {
-            queue.insertAfter(*before, bell);
-            (*iterator)->ms -= ms;
-            return;
-        }
+    // insert behind the last bell which is not due later
+    Bell *before = first;
+    for (Bell *other : queue) {
+        if (other->deadline > deadline)
+            break;
+        before = other;
     }
+    queue.insertAfter(before, bell);
 }
 
 void Bellringer::cancel(Bell *bell) {
-    Queue<Bell>::Iterator iterator = queue.begin();
-    while (iterator != queue.end()) {
-        if (*iterator == bell)
-            break;
-    }
-    if (*iterator == nullptr || *(++iterator) == nullptr)
-        return;
-    (*iterator)->ms += bell->ms;
     queue.remove(bell);
 }
 
 bool Bellringer::bellPending() {
-    return queue.first() == nullptr ? false : true;
+    return queue.first() != nullptr;
+}
+
+uint64_t Bellringer::next() {
+    Bell *first = queue.first();
+    return first == nullptr ? UINT64_MAX : first->deadline;
 }
@@ -11,10 +11,12 @@
  *  \ingroup ipc
  *
  *  The Bellringer is regularly activated and checks whether any of the bells should ring.
- *  The bells are stored in a Queue<Bell> that is managed by the Bellringer.
- *  A clever implementation avoids iterating through the whole list for every iteration by
- *  keeping the bells sorted and storing delta times. This approach leads to a complexity
- *  of O(1) for the method called by the timer interrupt in case no bells need to be rung.
+ *  The bells are stored in a Queue<Bell> that is managed by the Bellringer, sorted
+ *  by their absolute deadline (in TSC ticks). Hence, the method called by the timer
+ *  interrupt only has to compare the first deadline with the current time, resulting
+ *  in a complexity of O(1) in case no bells need to be rung.
+ *
+ *  \note Requires a calibrated TSC (see \ref TSC::ticks, done by \ref Watch::windup).
  */
 class Bellringer {
 	// Prevent copies and assignments
@@ -26,12 +28,7 @@ class Bellringer {
 	static Queue<Bell> queue;
 
  public:
-	/*! \brief Checks whether there are bells to be rung.
-	 *
-	 *  Every call to check elapses a tick. Once such a tick reduces a bells
-	 *  remaining time to zero, the bell will be rung.
-	 *
-	 *  \todo Implement Method
+	/*! \brief Rings all bells whose deadline has passed.
 	 */
 	static void check();
 
@@ -40,22 +37,31 @@ class Bellringer {
 	 *  \param bell Bell that should be rung after `ms` milliseconds
 	 *  \param ms number of milliseconds that should be waited before
 	 *  ringing the bell
-	 *
-	 *  \todo Implement Method
 	 */
 	static void job(Bell *bell, unsigned int ms);
 
+	/*! \brief Passes a `bell` to the bellringer to be rung at an absolute time.
+	 *
+	 *  If the bell becomes the next one to ring, the \ref Watch of the current
+	 *  core is asked to interrupt in time (only possible in TSC-deadline mode).
+	 *
+	 *  \param bell Bell that should be rung
+	 *  \param deadline timestamp (in TSC ticks)
+	 */
+	static void jobAt(Bell *bell, uint64_t deadline);
+
 	/*! \brief Cancel ticking & ringing a bell
 	 *  \param bell Bell that should not be rung.
-	 *
-	 *  \todo Implement Method
 	 */
 	static void cancel(Bell *bell);
 
 	/*! \brief Checks whether there are enqueued bells.
 	 *  \return true if there are enqueued bells, false otherwise
-	 *
-	 *  \todo Implement Method
 	 */
 	static bool bellPending();
+
+	/*! \brief Deadline of the next bell to be rung
+	 *  \return timestamp (in TSC ticks), or `UINT64_MAX` if no bell is pending
+	 */
+	static uint64_t next();
 };
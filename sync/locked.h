@@ -0,0 +1,66 @@
+/*! \file
+ *  \brief \ref Locked, a scoped \ref Ticketlock for data shared with prologues
+ */
+
+#pragma once
+
+#include "machine/core.h"
+#include "sync/ticketlock.h"
+
+/*! \brief Holds a \ref Ticketlock with interrupts disabled during its lifetime
+ *  \ingroup sync
+ *
+ * Data which is also accessed by interrupt handlers (or by code which must
+ * not be preempted while holding the lock, e.g. the memory allocators) needs
+ * the interrupts disabled on the local core -- otherwise a prologue could
+ * spin on the lock held by the code it interrupted. The previous interrupt
+ * state is restored when the lock is released:
+ *
+ *  \code{.cpp}
+ *	static Ticketlock lock{"Example"};
+ *	...
+ *	{
+ *	    Locked locked(lock);
+ *	    // critical section
+ *	}
+ *	\endcode
+ *
+ * Code which must not wait for the lock (e.g. because its holder might be
+ * interrupted by the caller) passes `wait = false` and checks \ref isHeld.
+ */
+class Locked {
+	// Prevent copies and assignments
+	Locked(const Locked&)            = delete;
+	Locked& operator=(const Locked&) = delete;
+
+	Ticketlock &lock;
+	const bool enabled;
+	bool held;
+
+ public:
+	/*! \brief Acquire the lock
+	 *
+	 * \param lock Lock to hold
+	 * \param wait `false` to give up (instead of spinning) if the lock is taken
+	 */
+	explicit Locked(Ticketlock &lock, bool wait = true) : lock(lock), enabled(Core::Interrupt::disable()), held(true) {
+		if (wait) {
+			lock.lock();
+		} else {
+			held = lock.tryLock();
+		}
+	}
+
+	~Locked() {
+		if (held) {
+			lock.unlock();
+		}
+		Core::Interrupt::restore(enabled);
+	}
+
+	/*! \brief Check if the lock was acquired (always the case with `wait`)
+	 */
+	bool isHeld() const {
+		return held;
+	}
+};
@@ -0,0 +1,101 @@
+#include "sync/lockstat.h"
+
+#ifdef LOCKSTAT
+
+#include "machine/tsc.h"
+#include "object/outputstream.h"
+
+static LockStat * registered = nullptr;
+
+LockStat::LockStat(const char *name) : name(name), next(nullptr) {
+    clear();
+    // locks might be constructed concurrently on different cores
+    LockStat * head = __atomic_load_n(&registered, __ATOMIC_RELAXED);
+    do {
+        next = head;
+    } while (!__atomic_compare_exchange_n(&registered, &head, this, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+void LockStat::acquired(uint64_t wait, bool contended, const void *address) {
+    hold_start = TSC::read();
+    acquisitions++;
+    if (contended)
+        this->contended++;
+    wait_total += wait;
+    if (wait > wait_max)
+        wait_max = wait;
+
+    // account the call site (replacing the least waiting one if necessary)
+    unsigned victim = 0;
+    for (unsigned i = 0; i < SITES; i++) {
+        if (site[i].address == address) {
+            victim = i;
+            break;
+        } else if (site[i].wait < site[victim].wait) {
+            victim = i;
+        }
+    }
+    if (site[victim].address != address) {
+        site[victim].address = address;
+        site[victim].acquisitions = 0;
+        site[victim].wait = 0;
+    }
+    site[victim].acquisitions++;
+    site[victim].wait += wait;
+}
+
+void LockStat::released() {
+    uint64_t hold = TSC::read() - hold_start;
+    hold_total += hold;
+    if (hold > hold_max)
+        hold_max = hold;
+}
+
+void LockStat::report(OutputStream &out) {
+    // The statistics are read without holding the locks, hence the values
+    // of an active lock might be slightly inconsistent.
+    static LockStat * sorted[64];
+    unsigned n = 0;
+    for (LockStat * lock = __atomic_load_n(&registered, __ATOMIC_ACQUIRE);
+         lock != nullptr && n < sizeof(sorted) / sizeof(sorted[0]); lock = lock->next) {
+        unsigned i = n++;
+        for (; i > 0 && sorted[i - 1]->wait_total < lock->wait_total; i--)
+            sorted[i] = sorted[i - 1];
+        sorted[i] = lock;
+    }
+
+    out << "lock: acquisitions (contended), wait total/max, hold total/max [cycles]" << endl;
+    for (unsigned i = 0; i < n; i++) {
+        LockStat * lock = sorted[i];
+        out << lock->name << ": " << lock->acquisitions << " (" << lock->contended << "), "
+            << lock->wait_total << "/" << lock->wait_max << ", "
+            << lock->hold_total << "/" << lock->hold_max << endl;
+        for (unsigned s = 0; s < SITES; s++) {
+            if (lock->site[s].address != nullptr)
+                out << "  at " << lock->site[s].address << ": " << lock->site[s].acquisitions
+                    << " acquisitions, " << lock->site[s].wait << " cycles waiting" << endl;
+        }
+    }
+}
+
+void LockStat::clear() {
+    acquisitions = 0;
+    contended = 0;
+    wait_total = 0;
+    wait_max = 0;
+    hold_total = 0;
+    hold_max = 0;
+    hold_start = 0;
+    for (unsigned s = 0; s < SITES; s++) {
+        site[s].address = nullptr;
+        site[s].acquisitions = 0;
+        site[s].wait = 0;
+    }
+}
+
+void LockStat::reset() {
+    for (LockStat * lock = __atomic_load_n(&registered, __ATOMIC_ACQUIRE); lock != nullptr; lock = lock->next)
+        lock->clear();
+}
+
+#endif
@@ -0,0 +1,92 @@
+/*! \file
+ *  \brief \ref LockStat "Lock contention statistics"
+ */
+
+#pragma once
+
+#include "types.h"
+
+class OutputStream;
+
+/*! \brief Per-lock contention statistics
+ *  \ingroup sync
+ *
+ *  Only available if the kernel is compiled with `-DLOCKSTAT` -- otherwise
+ *  this class does not exist and the locks do not contain any instrumentation
+ *  at all.
+ *
+ *  A lock embeds an instance and reports every acquisition (with the cycles
+ *  spent waiting and the acquiring call site) and every release. Both
+ *  reports are issued while the lock is held, hence the statistics are
+ *  protected by the lock itself.
+ *  All times are measured in TSC cycles.
+ *
+ *  Instances register themselves on construction (and are never removed, so
+ *  only locks with static storage duration should be instrumented).
+ *  A report of all locks
+ *  (sorted by total wait time) can be printed with \ref LockStat::report --
+ *  e.g. to \ref DBG, to a \ref SerialStream or via the `monitor locks`
+ *  command of the \ref GDB_Stub.
+ */
+#ifdef LOCKSTAT
+class LockStat {
+	// Prevent copies and assignments
+	LockStat(const LockStat&)            = delete;
+	LockStat& operator=(const LockStat&) = delete;
+
+	/// Number of distinct call sites tracked per lock
+	static const unsigned SITES = 4;
+
+	/// Name of the lock
+	const char * const name;
+
+	/// Next registered lock
+	LockStat * next;
+
+	uint64_t acquisitions;
+	uint64_t contended;
+	uint64_t wait_total;
+	uint64_t wait_max;
+	uint64_t hold_total;
+	uint64_t hold_max;
+
+	/// TSC at the last acquisition
+	uint64_t hold_start;
+
+	/// Call sites with the most wait cycles
+	struct {
+		const void * address;
+		uint64_t acquisitions;
+		uint64_t wait;
+	} site[SITES];
+
+	/// Reset the statistics of this lock
+	void clear();
+
+ public:
+	/*! \brief Constructor
+	 *  \param name Name of the lock in the report
+	 */
+	explicit LockStat(const char *name);
+
+	/*! \brief Record an acquisition (to be called with the lock held)
+	 *  \param wait Cycles spent waiting for the lock
+	 *  \param contended Whether the lock was held by someone else
+	 *  \param address Call site acquiring the lock
+	 */
+	void acquired(uint64_t wait, bool contended, const void *address);
+
+	/*! \brief Record a release (to be called while the lock is still held)
+	 */
+	void released();
+
+	/*! \brief Print the statistics of all locks, sorted by total wait time
+	 *  \param out Output stream
+	 */
+	static void report(OutputStream &out);
+
+	/*! \brief Reset the statistics of all locks
+	 */
+	static void reset();
+};
+#endif
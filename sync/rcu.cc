@@ -0,0 +1,72 @@
+#include "sync/rcu.h"
+#include "sync/waitingroom.h"
+#include "thread/scheduler.h"
+
+namespace RCU {
+
+Reader reader[Core::MAX]{};
+
+// Latest epoch handed out by call()
+static volatile uint64_t epoch = 0;
+
+static struct cache_aligned {
+    // Latest epoch this core has seen in a quiescent state
+    volatile uint64_t seen;
+    // Pending callbacks of this core, sorted by epoch
+    Queue<Head> callbacks;
+} local[Core::MAX];
+
+// Oldest epoch which has not been seen by all online cores
+static uint64_t completed() {
+    uint64_t min = __atomic_load_n(&epoch, __ATOMIC_ACQUIRE);
+    for (unsigned i = 0; i < Core::MAX; i++) {
+        if (Core::isOnline(i) && local[i].seen < min)
+            min = local[i].seen;
+    }
+    return min;
+}
+
+void quiescentState() {
+    unsigned id = Core::getID();
+    if (reader[id].nesting != 0)
+        return;
+    // order all previous reads before the announcement
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    local[id].seen = __atomic_load_n(&epoch, __ATOMIC_ACQUIRE);
+}
+
+void call(Head *head, void (*func)(Head *head)) {
+    assert(head != nullptr && func != nullptr);
+    head->func = func;
+    head->epoch = __atomic_add_fetch(&epoch, 1, __ATOMIC_SEQ_CST);
+    local[Core::getID()].callbacks.enqueue(head);
+}
+
+void check() {
+    Queue<Head> &callbacks = local[Core::getID()].callbacks;
+    if (callbacks.first() == nullptr)
+        return;
+    uint64_t done = completed();
+    while (callbacks.first() != nullptr && callbacks.first()->epoch <= done) {
+        Head *head = callbacks.dequeue();
+        head->func(head);
+    }
+}
+
+namespace {
+struct Synchronizer : public Head {
+    Waitingroom waitingroom;
+};
+}  // namespace
+
+void synchronize() {
+    Synchronizer sync;
+    call(&sync, [](Head *head) {
+        Thread *thread = static_cast<Synchronizer *>(head)->waitingroom.first();
+        if (thread != nullptr)
+            Scheduler::wakeup(thread);
+    });
+    Scheduler::block(&sync.waitingroom);
+}
+
+}  // namespace RCU
@@ -0,0 +1,138 @@
+/*! \file
+ *  \brief \ref RCU "Read-Copy-Update" for read-mostly data structures
+ */
+
+#pragma once
+
+#include "types.h"
+#include "object/queue.h"
+#include "machine/cache.h"
+#include "machine/core.h"
+
+/*! \brief Read-Copy-Update: lock-free readers, deferred reclamation for writers
+ *  \ingroup ipc
+ *
+ *  Readers of an RCU protected structure take no lock; they merely enclose
+ *  their access in \ref readLock / \ref readUnlock. A read-side critical
+ *  section must neither block nor yield -- while it is open, the \ref Watch
+ *  will not preempt the reader.
+ *
+ *  Writers (which still have to be serialized among each other, usually by
+ *  the \ref Guard) publish a new version with \ref assign and may only free
+ *  the old version once every core has passed a *quiescent state*, i.e. a
+ *  point at which it cannot hold a reference obtained earlier.
+ *  Such points are reported by \ref Dispatcher::dispatch on every context
+ *  switch and by the \ref IdleThread.
+ *
+ *  Reclamation is either asynchronous via \ref call (the callback is executed
+ *  in the \ref Watch epilogue as soon as the grace period has elapsed) or
+ *  synchronous by blocking the calling thread in \ref synchronize.
+ *
+ *  Grace periods are tracked with a global epoch: every \ref call starts a
+ *  new one, and each core remembers the latest epoch it has seen in a
+ *  quiescent state. A callback of epoch `e` is ready once all online cores
+ *  have seen an epoch `>= e`.
+ */
+namespace RCU {
+
+/*! \brief Embedded into objects which are reclaimed with \ref call
+ */
+struct Head : public Queue<Head>::Node {
+	/// Reclamation callback
+	void (*func)(Head *head);
+	/// Grace period which has to elapse before `func` is called
+	uint64_t epoch;
+
+	Head() : func(nullptr), epoch(0) {}
+};
+
+/*! \brief Core local reader state (cache aligned to prevent false sharing)
+ */
+struct cache_aligned Reader {
+	/// Nesting depth of read-side critical sections on this core
+	volatile unsigned nesting;
+};
+
+extern Reader reader[Core::MAX];
+
+/*! \brief Enter a read-side critical section (may be nested)
+ */
+inline void readLock() {
+	bool enabled = Core::Interrupt::disable();
+	reader[Core::getID()].nesting++;
+	Core::Interrupt::restore(enabled);
+}
+
+/*! \brief Leave a read-side critical section
+ */
+inline void readUnlock() {
+	bool enabled = Core::Interrupt::disable();
+	reader[Core::getID()].nesting--;
+	Core::Interrupt::restore(enabled);
+}
+
+/*! \brief Drop the read-side critical sections of the active thread
+ *
+ *  The nesting depth is kept per core: A thread leaving for good while
+ *  reading (killed by the \ref Assassin) would otherwise prevent its core
+ *  from ever reporting a quiescent state again, stalling all grace periods.
+ *
+ *  \note Has to be called on epilogue level before the thread is replaced.
+ */
+inline void abandon() {
+	bool enabled = Core::Interrupt::disable();
+	reader[Core::getID()].nesting = 0;
+	Core::Interrupt::restore(enabled);
+}
+
+/*! \brief Check if the current core is inside a read-side critical section
+ */
+inline bool isReading() {
+	return reader[Core::getID()].nesting != 0;
+}
+
+/*! \brief Load an RCU protected pointer (inside a read-side critical section)
+ */
+template<typename T>
+inline T dereference(const T &pointer) {
+	return __atomic_load_n(&pointer, __ATOMIC_CONSUME);
+}
+
+/*! \brief Publish a new value for an RCU protected pointer
+ *
+ *  All prior initialization of the pointee will be visible to readers
+ *  observing the new value.
+ */
+template<typename T>
+inline void assign(T &pointer, T value) {
+	__atomic_store_n(&pointer, value, __ATOMIC_RELEASE);
+}
+
+/*! \brief Report a quiescent state for the current core
+ *
+ *  Ignored if the core is in a read-side critical section.
+ */
+void quiescentState();
+
+/*! \brief Defer `func(head)` until all current readers are done
+ *
+ *  \note Has to be called on epilogue level.
+ *  \param head object embedded in the structure to be reclaimed
+ *  \param func callback, executed in an epilogue on the current core
+ */
+void call(Head *head, void (*func)(Head *head));
+
+/*! \brief Block the active thread until a full grace period has elapsed
+ *
+ *  \note Has to be called on epilogue level by a thread.
+ */
+void synchronize();
+
+/*! \brief Execute the callbacks of the current core whose grace period has
+ *  elapsed
+ *
+ *  Called by the \ref Watch epilogue on every core.
+ */
+void check();
+
+}  // namespace RCU
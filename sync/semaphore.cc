@@ -2,17 +2,28 @@
 #include "interrupt/guard.h"
 #include "thread/scheduler.h"
 
-void Semaphore::p() {
-    if (counter > 0)
-        counter--;
-    else
+void Semaphore::p(unsigned n) {
+    if (!try_p(n)) {
+        Scheduler::active()->permits = n;
         Scheduler::block(this);
+    }
 }
 
-void Semaphore::v() {
-    Thread* first = dequeue();
-    if (first != nullptr)
-        Scheduler::wakeup(first);
-    else
-        counter++;
+bool Semaphore::try_p(unsigned n) {
+    // waiting threads must not be overtaken
+    if (first() != nullptr || counter < n)
+        return false;
+    counter -= n;
+    return true;
+}
+
+void Semaphore::v(unsigned n) {
+    counter += n;
+    unsigned woken = 0;
+    for (Thread* customer = first(); customer != nullptr && customer->permits <= counter; customer = first()) {
+        counter -= customer->permits;
+        Scheduler::wakeup(customer, false);
+        woken++;
+    }
+    Scheduler::notify(woken);
 }
@@ -30,20 +30,36 @@ class Semaphore : public Waitingroom {
 
 	/*! \brief Wait for access to the critical area.
 	 *
-	 *  Enter/Wait operation: If the counter is greater than 0, then it is
-	 *  decremented by one. Otherwise the calling thread will be enqueued
-	 *  into the Waitingroom and marked as blocked.
+	 *  Enter/Wait operation: If the counter is at least `n` (and no other
+	 *  thread is waiting), then it is decremented by `n`. Otherwise the
+	 *  calling thread will be enqueued into the Waitingroom and marked as
+	 *  blocked until all `n` permits have been handed over to it.
+	 *
+	 *  \param n Number of permits to acquire
 	 *
 	 *  \todo Implement Method
 	 */
-	void p();
+	void p(unsigned n = 1);
+
+	/*! \brief Try to enter the critical area without blocking.
+	 *
+	 *  \param n Number of permits to acquire
+	 *  \return `true` if the permits were acquired, `false` if the calling
+	 *          thread would have been blocked by \ref p()
+	 */
+	bool try_p(unsigned n = 1);
 
 	/*! \brief Leave the critical area.
 	 *
-	 *  Leave operation: If there are threads in the Waitingroom, wake the
-	 *  first one; otherwise increment the counter by one.
+	 *  Leave operation: Increment the counter by `n` and hand the permits to
+	 *  the threads in the Waitingroom (in FIFO order, as long as the demand
+	 *  of the first one can be satisfied).
+	 *  All threads are woken up in one go, so idle cores are notified with at
+	 *  most one IPI each.
+	 *
+	 *  \param n Number of permits to release
 	 *
 	 *  \todo Implement Method
 	 */
-	void v();
+	void v(unsigned n = 1);
 };
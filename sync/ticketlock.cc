@@ -1,5 +1,29 @@
 #include "sync/ticketlock.h"
+#ifdef LOCKSTAT
+#include "machine/tsc.h"
+#endif
 
+#ifdef LOCKSTAT
+void Ticketlock::lock() {
+    lock(__builtin_return_address(0));
+}
+
+void Ticketlock::lock(void (*waiting)()) {
+    lock(__builtin_return_address(0), waiting);
+}
+
+void Ticketlock::lock(const void *site, void (*waiting)()) {
+    uint64_t start = TSC::read();
+    uint64_t ticket = __atomic_fetch_add(&ticket_count, 1, __ATOMIC_SEQ_CST);
+    bool contended = ticket != ticket_current;
+    while (ticket != ticket_current) {
+        if (waiting != nullptr)
+            waiting();
+        Core::pause();
+    }
+    stat.acquired(TSC::read() - start, contended, site);
+}
+#else
 void Ticketlock::lock() {
     uint64_t ticket = __atomic_fetch_add(&ticket_count, 1, __ATOMIC_SEQ_CST);
     while (ticket != ticket_current) {
@@ -7,6 +31,30 @@ void Ticketlock::lock() {
     }
 }
 
+void Ticketlock::lock(void (*waiting)()) {
+    uint64_t ticket = __atomic_fetch_add(&ticket_count, 1, __ATOMIC_SEQ_CST);
+    while (ticket != ticket_current) {
+        if (waiting != nullptr)
+            waiting();
+        Core::pause();
+    }
+}
+#endif
+
+bool Ticketlock::tryLock() {
+    // only succeeds if nobody holds (or waits for) the lock
+    uint64_t ticket = __atomic_load_n(&ticket_current, __ATOMIC_SEQ_CST);
+    if (!__atomic_compare_exchange_n(&ticket_count, &ticket, ticket + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        return false;
+#ifdef LOCKSTAT
+    stat.acquired(0, false, __builtin_return_address(0));
+#endif
+    return true;
+}
+
 void Ticketlock::unlock() {
+#ifdef LOCKSTAT
+    stat.released();
+#endif
     __atomic_fetch_add(&ticket_current, 1, __ATOMIC_SEQ_CST);
 }
@@ -6,6 +6,7 @@
 
 #include "machine/core.h"
 #include "machine/cache.h"
+#include "sync/lockstat.h"
 
 /*! \brief By the use of Ticketlocks, it is possible to serialize blocks of code
  *  that might run parallel on multiple CPU cores.
@@ -23,6 +24,8 @@
  *        This is not the most efficient memory order but works reasonably well.
  *
  *  <a href="https://gcc.gnu.org/onlinedocs/gcc/_005f_005fatomic-Builtins.html">Atomic Builtins in GCC manual</a>
+ *
+ *  With `-DLOCKSTAT` every Ticketlock gathers contention statistics (see \ref LockStat).
  */
 class Ticketlock {
 	// Prevent copies and assignments
@@ -32,13 +35,24 @@ class Ticketlock {
  private:
 	volatile uint64_t ticket_current;
 	volatile uint64_t ticket_count;
+#ifdef LOCKSTAT
+	LockStat stat;
+#endif
 
  public:
 	/*! \brief Constructor
+	 *
+	 * \param name Name of the lock in the \ref LockStat report
 	 *
 	 * \todo Complete Constructor (for \MPStuBS)
 	 */
-	Ticketlock() : ticket_current(0), ticket_count(0) {}
+	explicit Ticketlock(const char *name = "Ticketlock") : ticket_current(0), ticket_count(0)
+#ifdef LOCKSTAT
+		, stat(name)
+#endif
+	{
+		(void) name;
+	}
 
 	/*! \brief Enters the critical area. In case the area is already locked,
 	 *  \ref lock() will actively wait for the area can be entered.
@@ -48,6 +62,27 @@ class Ticketlock {
 	 */
 	void lock();
 
+	/*! \brief Like \ref lock(), but calls `waiting` in each iteration of the
+	 *  busy wait (unless it is `nullptr`)
+	 *
+	 * Allows a core spinning with interrupts disabled to serve requests the
+	 * lock holder might wait for (e.g. \ref RemoteCall::poll()).
+	 */
+	void lock(void (*waiting)());
+
+#ifdef LOCKSTAT
+	/*! \brief Like \ref lock(void (*)()), but accounts the acquisition to the
+	 *  call site `site` (for wrappers like the \ref Guard)
+	 */
+	void lock(const void *site, void (*waiting)() = nullptr);
+#endif
+
+	/*! \brief Enters the critical area only if it is free (without waiting)
+	 *
+	 * \return `true` if the lock was acquired
+	 */
+	bool tryLock();
+
 	/*! \brief Unblocks the critical area.
 	 *
 	 * \todo Implement Method (for \MPStuBS)
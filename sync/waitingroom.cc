@@ -2,9 +2,11 @@
 #include "thread/scheduler.h"
 
 Waitingroom::~Waitingroom() {
-    for (Thread* customer = dequeue(); customer != nullptr; customer = dequeue()) {
-        Scheduler::wakeup(customer);
+    unsigned woken = 0;
+    for (Thread* customer = dequeue(); customer != nullptr; customer = dequeue(), woken++) {
+        Scheduler::wakeup(customer, false);
     }
+    Scheduler::notify(woken);
 }
 
 void Waitingroom::remove(Thread* customer) {
@@ -16,6 +16,10 @@ class GuardedGraphics : public Graphics {
 	 */
 	GuardedGraphics(unsigned size, void* frontbuffer, void* backbuffer) : Graphics(size, frontbuffer, backbuffer) {}
 
+	/*! \brief The buffers are allocated at runtime (see \ref Graphics::Graphics())
+	 */
+	GuardedGraphics() : Graphics() {}
+
 	/*! \copydoc Graphics::switchBuffers()
 	 *
 	 * \note This method is equal to the correspondent method in base class
@@ -35,9 +35,20 @@ class GuardedSemaphore : private Semaphore {
 	 *
 	 *  \todo Implement method
 	 */
-	void p() {
+	void p(unsigned n = 1) {
 		Guarded guard;
-		Semaphore::p();
+		Semaphore::p(n);
+	}
+
+	/*! \copydoc Semaphore::try_p()
+	 *
+	 * \note This method is equal to the correspondent method in base class
+	 *       \ref Semaphore, with the only difference that the call will be
+	 *       protected by a \ref Guarded object.
+	 */
+	bool try_p(unsigned n = 1) {
+		Guarded guard;
+		return Semaphore::try_p(n);
 	}
 
 	/*! \copydoc Semaphore::v()
@@ -48,8 +59,8 @@ class GuardedSemaphore : private Semaphore {
 	 *
 	 *  \todo Implement method
 	 */
-	void v() {
+	void v(unsigned n = 1) {
 		Guarded guard;
-		Semaphore::v();
+		Semaphore::v(n);
 	}
 };
@@ -1,5 +1,6 @@
 #include "thread/assassin.h"
 #include "interrupt/plugbox.h"
+#include "sync/rcu.h"
 #include "thread/dispatcher.h"
 #include "thread/scheduler.h"
 
@@ -14,6 +15,9 @@ bool Assassin::prologue() {
 }
 
 void Assassin::epilogue() {
-    if (Dispatcher::active()->kill_flag)
+    if (Dispatcher::active()->kill_flag) {
+        // the victim might have been interrupted inside a read-side section
+        RCU::abandon();
         Scheduler::resume();
+    }
 }
@@ -1,6 +1,5 @@
 #include "thread/dispatcher.h"
-
-Thread* Dispatcher::life_pointer[Core::MAX]{};
+#include "sync/rcu.h"
 
 void Dispatcher::go(Thread* first) {
     assert(first != nullptr);
@@ -11,13 +10,14 @@ void Dispatcher::go(Thread* first) {
 void Dispatcher::dispatch(Thread* next) {
     assert(next != nullptr);
     Thread* current = active();
+    RCU::quiescentState();
     setActive(next);
     current->resume(next);
 }
 
 bool Dispatcher::isActive(const Thread* thread, unsigned* cpu) {
     for (unsigned i = 0; i < Core::MAX; i++) {
-        if (life_pointer[i] == thread) {
+        if (Core::getLocal(i)->thread == thread) {
             if (cpu != nullptr)
                 *cpu = i;
             return true;
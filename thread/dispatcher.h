@@ -14,12 +14,11 @@
  *  active thread and performs the actual switching of processes.
  *  For single-core systems, a single life pointer is sufficient, as only a
  *  single thread can be active at any one time. On multi-core systems,
- *  every CPU core needs its own life pointer.
+ *  every CPU core needs its own life pointer, which is kept in the
+ *  \ref Core::Local "per-core data area".
  */
 class Dispatcher {
  private:
-	static Thread* life_pointer[Core::MAX];
-
 	/*! \brief private constructor to prevent instantiation
 	 */
 	Dispatcher();
@@ -28,7 +27,7 @@ class Dispatcher {
 	 *  \param thread active Thread
 	 */
 	static void setActive(Thread* thread) {
-		life_pointer[Core::getID()] = thread;
+		Core::setThread(thread);
 	}
 
  public:
@@ -39,7 +38,7 @@ class Dispatcher {
 	 *  \todo Implement Method
 	 */
 	static Thread* active() {
-		return life_pointer[Core::getID()];
+		return Core::getThread();
 	}
 
 	/*! \brief This method stores `first` as life pointer for this CPU core and
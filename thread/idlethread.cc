@@ -1,5 +1,6 @@
 #include "thread/idlethread.h"
 #include "machine/core.h"
+#include "sync/rcu.h"
 #include "syscall/guarded_scheduler.h"
 #include "thread/scheduler.h"
 
@@ -8,6 +9,7 @@ IdleThread idlethread[Core::MAX]{};
 void IdleThread::action() {
     while (true) {
         Core::Interrupt::disable();
+        RCU::quiescentState();
         if (Scheduler::isEmpty()) {
             Core::idle();
         } else {
@@ -0,0 +1,40 @@
+#include "thread/irqthread.h"
+#include "interrupt/guarded.h"
+#include "machine/core.h"
+#include "machine/tsc.h"
+#include "sync/rcu.h"
+#include "thread/scheduler.h"
+
+IRQThread irqthread[Core::MAX]{};
+
+void IRQThread::action() {
+    Guarded section;
+    while (true) {
+        Request request;
+        while (pending.consume(request)) {
+            uint64_t latency = TSC::read() - request.raised;
+            handled++;
+            latency_total += latency;
+            if (latency > latency_max)
+                latency_max = latency;
+            request.gate->epilogue();
+        }
+        Scheduler::block(&waitingroom);
+    }
+}
+
+bool IRQThread::handover(Gate* gate) {
+    IRQThread* thread = &irqthread[Core::getID()];
+    if (!thread->pending.produce({gate, TSC::read()}))
+        return false;
+
+    // an active interrupt thread will find the request before blocking
+    if (!Scheduler::isActive(thread)) {
+        Scheduler::readyFirst(thread);
+        if (RCU::isReading())
+            Scheduler::notify(1);
+        else
+            Scheduler::preempt();
+    }
+    return true;
+}
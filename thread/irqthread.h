@@ -0,0 +1,88 @@
+/*! \file
+ *  \brief \ref IRQThread executing the epilogues of threaded \ref Gate "gates"
+ */
+
+#pragma once
+
+#include "thread/thread.h"
+#include "interrupt/gate.h"
+#include "object/bbuffer.h"
+#include "sync/waitingroom.h"
+
+/*! \brief Interrupt thread executing the epilogues of threaded gates.
+ *  \ingroup thread
+ *
+ * Each core has one interrupt thread. If a \ref Gate is marked as `threaded`,
+ * \ref Guard::leave does not execute its epilogue inline, but hands it over
+ * to the interrupt thread of the current core, which is scheduled with top
+ * priority (and immediately preempts the active thread, unless the latter is
+ * in an \ref RCU read-side critical section).
+ *
+ * The epilogue is still executed on epilogue level, but since it is now a
+ * thread, it may be preempted by the \ref Watch and delays other epilogues
+ * only until the handover. However, as the ready list is shared, the
+ * interrupt thread might be executed on a different core: threaded
+ * epilogues must not rely on \ref Core::getID().
+ *
+ * The latency between the handover and the start of the epilogue is
+ * measured in TSC cycles and included in the \ref IRQStat::report (e.g. via
+ * the `monitor interrupts` command of the \ref GDB_Stub).
+ */
+class IRQThread : public Thread {
+	// Prevent copies and assignments
+	IRQThread(const IRQThread&)            = delete;
+	IRQThread& operator=(const IRQThread&) = delete;
+
+	/// Epilogue handed over to the interrupt thread
+	struct Request {
+		Gate* gate;
+		uint64_t raised;
+	};
+	BBuffer<Request, 32> pending;
+
+	/// Idle interrupt thread waits here
+	Waitingroom waitingroom;
+
+	uint64_t handled;
+	uint64_t latency_total;
+	uint64_t latency_max;
+
+ public:
+	/*! \brief Constructor
+	 */
+	IRQThread() : handled(0), latency_total(0), latency_max(0) {}
+
+	/*! \brief Executes the pending epilogues (and sleeps otherwise)
+	 */
+	void action() override;
+
+	/*! \brief Hand the epilogue of `gate` over to the interrupt thread of the
+	 *  current core
+	 *
+	 * \note Has to be called on epilogue level.
+	 * \param gate Threaded gate
+	 * \return `false` if the interrupt thread is overloaded -- in this case
+	 *         the caller has to execute the epilogue itself
+	 */
+	static bool handover(Gate* gate);
+
+	/*! \brief Number of epilogues executed by this thread
+	 */
+	uint64_t count() const {
+		return handled;
+	}
+
+	/*! \brief Maximum latency from handover to epilogue in TSC cycles
+	 */
+	uint64_t maxLatency() const {
+		return latency_max;
+	}
+
+	/*! \brief Average latency from handover to epilogue in TSC cycles
+	 */
+	uint64_t averageLatency() const {
+		return handled == 0 ? 0 : latency_total / handled;
+	}
+};
+
+extern IRQThread irqthread[];
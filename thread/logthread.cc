@@ -0,0 +1,12 @@
+#include "thread/logthread.h"
+#include "debug/klog.h"
+#include "syscall/guarded_bell.h"
+
+LogThread logthread{};
+
+void LogThread::action() {
+    while (true) {
+        KLog::drain();
+        GuardedBell::sleep(PERIOD);
+    }
+}
@@ -0,0 +1,36 @@
+/*! \file
+ *  \brief \ref LogThread draining the \ref KLog "kernel log"
+ */
+
+#pragma once
+
+#include "thread/thread.h"
+
+/*! \brief Background thread formatting the \ref KLog records
+ *  \ingroup thread
+ *
+ * Every \ref PERIOD milliseconds, the pending records of all cores are
+ * \ref KLog::drain "drained" to the attached sinks. Formatting happens
+ * outside of the \ref Guard, so the (slow) output does not delay the
+ * epilogues of other cores.
+ */
+class LogThread : public Thread {
+	// Prevent copies and assignments
+	LogThread(const LogThread&)            = delete;
+	LogThread& operator=(const LogThread&) = delete;
+
+ public:
+	/*! \brief Interval between two drains in milliseconds
+	 */
+	static const unsigned PERIOD = 20;
+
+	/*! \brief Constructor
+	 */
+	LogThread() {}
+
+	/*! \brief Periodically drains the kernel log
+	 */
+	void action() override;
+};
+
+extern LogThread logthread;
@@ -0,0 +1,39 @@
+#include "thread/pollthread.h"
+#include "interrupt/guarded.h"
+#include "machine/ioapic.h"
+#include "thread/scheduler.h"
+
+PollThread pollthread{};
+
+void PollThread::action() {
+    Guarded section;
+    while (true) {
+        PollGate* gate = pending.dequeue();
+        if (gate == nullptr) {
+            Scheduler::block(&waitingroom);
+            continue;
+        }
+        unsigned n = gate->poll(BUDGET);
+        batches++;
+        items += n;
+        if (n < BUDGET) {
+            // drained -- back to interrupt mode
+            gate->scheduled = false;
+            IOAPIC::allow(gate->slot);
+        } else {
+            // still busy -- poll again after giving others a chance
+            pending.enqueue(gate);
+            Scheduler::resume();
+        }
+    }
+}
+
+void PollThread::schedule(PollGate* gate) {
+    if (gate->scheduled)
+        return;
+    gate->scheduled = true;
+    pollthread.pending.enqueue(gate);
+    Thread* thread = pollthread.waitingroom.first();
+    if (thread != nullptr)
+        Scheduler::wakeup(thread);
+}
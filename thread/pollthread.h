@@ -0,0 +1,68 @@
+/*! \file
+ *  \brief \ref PollThread servicing \ref PollGate "polled devices"
+ */
+
+#pragma once
+
+#include "thread/thread.h"
+#include "interrupt/pollgate.h"
+#include "object/queue.h"
+#include "sync/waitingroom.h"
+
+/*! \brief Thread draining the devices whose interrupts are masked
+ *  \ingroup thread
+ *
+ * The \ref PollGate "devices" scheduled by their epilogues are serviced
+ * round robin (on epilogue level) with a budget of \ref BUDGET items per
+ * turn. Drained devices get their interrupt line unmasked; busy ones are
+ * polled again after the thread yielded the processor once. If no device
+ * is pending, the thread sleeps.
+ */
+class PollThread : public Thread {
+	// Prevent copies and assignments
+	PollThread(const PollThread&)            = delete;
+	PollThread& operator=(const PollThread&) = delete;
+
+	/// Devices to be serviced
+	Queue<PollGate> pending;
+
+	/// Idle poll thread waits here
+	Waitingroom waitingroom;
+
+	uint64_t batches;
+	uint64_t items;
+
+ public:
+	/*! \brief Maximum number of items handled per device and turn
+	 */
+	static const unsigned BUDGET = 64;
+
+	/*! \brief Constructor
+	 */
+	PollThread() : batches(0), items(0) {}
+
+	/*! \brief Services the pending devices (and sleeps otherwise)
+	 */
+	void action() override;
+
+	/*! \brief Schedule a device to be serviced
+	 *
+	 * \note Has to be called on epilogue level.
+	 * \param gate Device with masked interrupt line
+	 */
+	static void schedule(PollGate* gate);
+
+	/*! \brief Number of \ref PollGate::poll calls
+	 */
+	uint64_t countBatches() const {
+		return batches;
+	}
+
+	/*! \brief Number of items handled in all batches
+	 */
+	uint64_t countItems() const {
+		return items;
+	}
+};
+
+extern PollThread pollthread;
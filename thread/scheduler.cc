@@ -1,12 +1,16 @@
 #include "thread/scheduler.h"
 #include "machine/apic.h"
 #include "machine/lapic.h"
+#include "sync/rcu.h"
 #include "sync/waitingroom.h"
 #include "thread/idlethread.h"
 
 Queue<Thread> Scheduler::readylist{};
 
 void Scheduler::exit() {
+    // a read-side critical section must not span the end of a thread
+    assert(!RCU::isReading());
+    RCU::abandon();
     Thread* thread = readylist.dequeue();
     if (thread == nullptr)
         thread = &idlethread[Core::getID()];
@@ -38,6 +42,23 @@ void Scheduler::resume() {
     dispatch(thread);
 }
 
+void Scheduler::readyFirst(Thread* that) {
+    if (that->getWaitingroom() != nullptr)
+        that->getWaitingroom()->remove(that);
+    else
+        readylist.remove(that);
+    readylist.insertFirst(that);
+}
+
+void Scheduler::preempt() {
+    Thread* thread = readylist.dequeue();
+    if (thread == nullptr)
+        return;
+    if (!active()->kill_flag && active() != &idlethread[Core::getID()])
+        readylist.insertFirst(active());
+    dispatch(thread);
+}
+
 void Scheduler::schedule() {
     Thread* thread = readylist.dequeue();
     if (thread == nullptr)
@@ -54,8 +75,22 @@ void Scheduler::block(Waitingroom* waitingroom) {
     dispatch(thread);
 }
 
-void Scheduler::wakeup(Thread* customer) {
+void Scheduler::wakeup(Thread* customer, bool ipi) {
     customer->getWaitingroom()->remove(customer);
     readylist.enqueue(customer);
-    LAPIC::IPI::sendOthers(Core::Interrupt::WAKEUP);
+    if (ipi)
+        notify(1);
+}
+
+void Scheduler::notify(unsigned n) {
+    uint8_t destination = 0;
+    unsigned self = Core::getID();
+    for (unsigned i = 0; i < Core::MAX && n > 0; i++) {
+        if (i != self && Core::isOnline(i) && isActive(&idlethread[i])) {
+            destination |= APIC::getLogicalAPICID(i);
+            n--;
+        }
+    }
+    if (destination != 0)
+        LAPIC::IPI::sendGroup(destination, Core::Interrupt::WAKEUP);
 }
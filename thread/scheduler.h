@@ -91,11 +91,47 @@ class Scheduler : public Dispatcher {
 	 */
 	static void resume();
 
+	/*! \brief Make a thread ready with top priority
+	 *
+	 *  `that` is removed from its \ref Waitingroom (if blocked) and
+	 *  inserted at the head of the ready list.
+	 *
+	 *  \param that Thread to be executed next
+	 */
+	static void readyFirst(Thread* that);
+
+	/*! \brief Immediately switch to the first thread of the ready list
+	 *
+	 *  Unlike \ref resume, the active thread does not lose its position:
+	 *  it is inserted at the head of the ready list and therefore continues
+	 *  right after the preempting thread.
+	 */
+	static void preempt();
+
 	static bool isEmpty() {
 		return readylist.first() == nullptr;
 	}
 
 	static void block(Waitingroom* waitingroom);
 
-	static void wakeup(Thread* customer);
+	/*! \brief Wake up a blocked thread
+	 *
+	 *  Removes the thread from its \ref Waitingroom and appends it to the
+	 *  ready list.
+	 *
+	 *  \param customer Thread to be woken up
+	 *  \param ipi Notify an idle core (pass `false` when waking several
+	 *         threads at once and call \ref notify afterwards)
+	 */
+	static void wakeup(Thread* customer, bool ipi = true);
+
+	/*! \brief Notify up to `n` idle cores about new threads in the ready list
+	 *
+	 *  Sends a single \ref Core::Interrupt::WAKEUP IPI to (at most) `n` cores
+	 *  currently executing their \ref IdleThread -- busy cores will pick the
+	 *  threads up on their next scheduling decision anyway.
+	 *
+	 *  \param n Number of threads that became ready
+	 */
+	static void notify(unsigned n);
 };
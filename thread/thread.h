@@ -13,6 +13,7 @@
 #pragma once
 
 #include "machine/context.h"
+#include "memory/arena.h"
 #include "object/queue.h"
 #include "sync/waitingroom.h"
 
@@ -71,6 +72,16 @@ class Thread : public Queue<Thread>::Node {
 	 */
 	volatile bool kill_flag;
 
+	/*! \brief Number of permits the thread is waiting for while blocked on
+	 *  a \ref Semaphore
+	 */
+	unsigned permits;
+
+	/*! \brief Arena for temporary allocations of this thread
+	 *  (see \ref Arena::scratch)
+	 */
+	Arena scratch;
+
 	/*! \brief Constructor
 	 *  Initializes the context using \ref prepareContext with the highest
 	 *  aligned address of the `reserved_stack_space` array as stack pointer
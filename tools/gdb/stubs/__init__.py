@@ -66,6 +66,38 @@ class PageVisualizer(gdb.Command):
             raise e
         pass
 
+class MappingVisualizer(gdb.Command):
+    """list all mapped regions: mapview [<cr3>]"""
+
+    def __init__(self, monitor):
+        super(MappingVisualizer, self).__init__("mapview", gdb.COMMAND_SUPPORT)
+        self.monitor = monitor
+        pass
+
+    def invoke(self, arg, from_tty):
+        args = gdb.string_to_argv(arg)
+        if len(args) == 0:
+            base = _active_cr3()
+        elif len(args) == 1:
+            base = gdb.parse_and_eval(args[0])
+        else:
+            raise gdb.GdbError("mapview [<cr3>]")
+
+        try:
+            mmu = paging.MMU(self.monitor, paging.Arch.X86_64)
+            names = {4096: '4K', 4096 << 9: '2M', 4096 << 18: '1G'}
+            for va, pa, size, attrs in mmu.regions(int(base)):
+                flags = [k for k in ['rw', 'us', 'pwt', 'pcd', 'pat', 'g', 'xd'] if attrs[k]]
+                print(
+                    f"0x{va:016x}-0x{va + size - 1:016x} -> 0x{pa:x} "
+                    f"({size // attrs['page']} x {names[attrs['page']]}) "
+                    f"[{'|'.join(flags)}]"
+                )
+        except Exception as e:
+            traceback.print_exc()
+            raise e
+        pass
+
 def _gdtidtargs(arg, kind):
     args = gdb.string_to_argv(arg)
     if len(args) == 0:
@@ -179,5 +211,6 @@ def current_cpuid():
 
 InterruptGateVisualizer(qemu)
 PageVisualizer(qemu)
+MappingVisualizer(qemu)
 GDTVisualizer(qemu)
 CurThread()
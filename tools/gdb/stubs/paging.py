@@ -136,6 +136,8 @@ class PTEntry(PageTableEntry):
         super().__init__(base, idx, mmu, value)
         self.d = helper.bits(value, 6, 1)
         self.g = helper.bits(value, 8, 1)
+        # bit 7 is the PAT bit for 4 KiB pages
+        self.pat = helper.bits(value, 7, 1)
         self.xd = helper.bits(value, 63, 1)
 
     def name(self):
@@ -146,8 +148,8 @@ class PTEntry(PageTableEntry):
             return f"[p:0|raw: {self.raw:x}]"
         desc = [
             "p:1", f"rw:{self.rw}", f"us:{self.us}", f"pwt:{self.pwt}",
-            f"pcd:{self.pcd}", f"a:{self.a}", f"d:{self.d}", f"ps:{self.ps}",
-            f"g:{self.g}", f"r:{self.r}", f"r:{self.r}",
+            f"pcd:{self.pcd}", f"a:{self.a}", f"d:{self.d}", f"pat:{self.pat}",
+            f"g:{self.g}", f"r:{self.r}",
             f"addr:0x{self.reference:x}", f"rsvd:{self.rsvd}", f"xd:{self.xd}"
         ]
         return "[" + str.join('|', desc) + f"] = {self.raw:x}"
@@ -308,6 +310,52 @@ class MMU:
         physical = pt_entry.addr()
         return physical, 4096, parts[0][4], entries
 
+    def mappings(self, base: int):
+        """yields (virtual, physical, size, entry) for each mapped page"""
+        levels = [
+            (PML4Table, 39),
+            (PageDirectoryPointerTable, 30),
+            (PageDirectory, 21),
+            (PageTable, 12)
+        ]
+
+        def walk(addr, level, vbase):
+            table, shift = levels[level]
+            for idx, entry in table(self, addr):
+                if not entry.present:
+                    continue
+                va = vbase | (idx << shift)
+                # canonical form of the upper half
+                if level == 0 and va & (1 << 47):
+                    va |= 0xffff << 48
+                if level == 3 or (level > 0 and entry.ps):
+                    yield va, entry.addr(), 1 << shift, entry
+                else:
+                    yield from walk(entry.addr(), level + 1, va)
+
+        yield from walk(base, 0, 0)
+
+    def regions(self, base: int):
+        """merges contiguous mappings with the same page size and attributes
+        into (virtual, physical, size, attributes)"""
+        region = None
+        for va, pa, size, entry in self.mappings(base):
+            attrs = {
+                'page': size, 'rw': entry.rw, 'us': entry.us,
+                'pwt': entry.pwt, 'pcd': entry.pcd,
+                'pat': entry.pat,
+                'g': entry.g, 'xd': entry.xd
+            }
+            if region is not None and region[0] + region[2] == va \
+                    and region[1] + region[2] == pa and region[3] == attrs:
+                region[2] += size
+                continue
+            if region is not None:
+                yield tuple(region)
+            region = [va, pa, size, attrs]
+        if region is not None:
+            yield tuple(region)
+
     def linear_bytes(self, mapping, addr, len):
         chunks = []
         while len > 0:
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+"""Flood the serial interface of a running Qemu instance.
+
+Qemu (started with `-serial pty`, the default of `make qemu`) reports the
+pseudo terminal it uses for the first serial interface, e.g.
+`char device redirected to /dev/pts/3 (label serial0)`.
+
+Usage: tools/serialflood.py /dev/pts/3 [blocks]
+
+Sends `blocks` blocks of 64 KiB (the block size of the SerialBenchmark in
+`user/bench/serialbench.cc`, requires a kernel built with `-DBENCHMARK`)
+as fast as possible and prints the throughput observed by the host.
+"""
+
+import os
+import sys
+import termios
+import time
+import tty
+
+BLOCK = 64 * 1024
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    blocks = int(sys.argv[2]) if len(sys.argv) > 2 else 16
+
+    fd = os.open(sys.argv[1], os.O_WRONLY | os.O_NOCTTY)
+    tty.setraw(fd)
+    data = bytes(i % 251 for i in range(BLOCK))
+
+    start = time.monotonic()
+    for _ in range(blocks):
+        view = memoryview(data)
+        while view:
+            written = os.write(fd, view)
+            view = view[written:]
+    termios.tcdrain(fd)
+    duration = time.monotonic() - start
+    os.close(fd)
+
+    total = blocks * BLOCK
+    print(f"{total} bytes in {duration:.2f}s: {total / duration / 1024:.1f} KiB/s")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,119 @@
+#include "user/bench/heapbench.h"
+#include "debug/output.h"
+#include "interrupt/guarded.h"
+#include "machine/core.h"
+#include "machine/tsc.h"
+#include "memory/heap.h"
+#include "syscall/guarded_scheduler.h"
+#include "utils/alloc.h"
+
+HeapBenchmark heapbench[Core::MAX]{};
+
+static const unsigned ROUNDS = 10000;
+static const unsigned LIVE = 256;
+static const unsigned LARGE = 64;
+
+static volatile unsigned arrived = 0;
+
+// blocks kept alive by each core
+static void *blocks[Core::MAX][LIVE];
+
+// wait until the benchmark threads on all cores are running
+static void barrier(unsigned round) {
+    __atomic_add_fetch(&arrived, 1, __ATOMIC_SEQ_CST);
+    while (arrived < round * Core::countOnline())
+        Core::pause();
+}
+
+namespace {
+struct Object {
+    uint64_t value[4];
+};
+}  // namespace
+
+void HeapBenchmark::action() {
+    unsigned id = static_cast<unsigned>(this - heapbench);
+    if (id >= Core::countOnline())
+        GuardedScheduler::exit();
+
+    void **live = blocks[id];
+    unsigned seed = id + 1;
+    auto random = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return seed >> 16;
+    };
+    unsigned failed = 0;
+
+    barrier(1);
+    uint64_t start = TSC::read(TSC::CPUID_RDTSC);
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        void *p = malloc(64);
+        failed += p == nullptr;
+        free(p);
+    }
+    uint64_t pair = (TSC::read(TSC::RDTSCP_CPUID) - start) / ROUNDS;
+
+    barrier(2);
+    start = TSC::read(TSC::CPUID_RDTSC);
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        unsigned slot = random() % LIVE;
+        free(live[slot]);
+        live[slot] = malloc(16 + random() % 4096);
+        failed += live[slot] == nullptr;
+    }
+    uint64_t mixed = (TSC::read(TSC::RDTSCP_CPUID) - start) / ROUNDS;
+    for (unsigned i = 0; i < LIVE; i++) {
+        free(live[i]);
+        live[i] = nullptr;
+    }
+
+    barrier(3);
+    start = TSC::read(TSC::CPUID_RDTSC);
+    for (unsigned i = 0; i < ROUNDS / 10; i++) {
+        unsigned slot = random() % LARGE;
+        free(live[slot]);
+        live[slot] = malloc((16 + random() % 241) * 1024);
+        failed += live[slot] == nullptr;
+    }
+    uint64_t large = (TSC::read(TSC::RDTSCP_CPUID) - start) / (ROUNDS / 10);
+    for (unsigned i = 0; i < LIVE; i++) {
+        free(live[i]);
+        live[i] = nullptr;
+    }
+
+    barrier(4);
+    start = TSC::read(TSC::CPUID_RDTSC);
+    void *buffer = nullptr;
+    for (unsigned i = 1; i <= ROUNDS / 10; i++) {
+        void *p = realloc(buffer, i * 1024);
+        if (p == nullptr) {
+            failed++;
+            break;
+        }
+        buffer = p;
+    }
+    free(buffer);
+    uint64_t grow = (TSC::read(TSC::RDTSCP_CPUID) - start) / (ROUNDS / 10);
+
+    barrier(5);
+    start = TSC::read(TSC::CPUID_RDTSC);
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        Object *o = new Object;
+        failed += o == nullptr;
+        delete o;
+    }
+    uint64_t object = (TSC::read(TSC::RDTSCP_CPUID) - start) / ROUNDS;
+
+    {
+        Guarded section;
+        DBG << "heap: pair " << pair << " mixed " << mixed << " large " << large
+            << " realloc " << grow << " new " << object << " cycles"
+            << (failed != 0 ? " (failures!)" : "") << endl;
+        if (id == 0) {
+            Heap::Stats stats = Heap::stats();
+            DBG << "heap: " << stats.used << " of " << stats.total << " bytes used, "
+                << stats.cached << " cached" << endl;
+        }
+    }
+    GuardedScheduler::exit();
+}
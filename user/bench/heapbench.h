@@ -0,0 +1,33 @@
+#pragma once
+
+#include "thread/thread.h"
+
+/*! \brief Allocation benchmark for the kernel \ref Heap
+ *
+ * One instance per core runs the same allocation patterns concurrently and
+ * prints the average cost per operation in TSC cycles:
+ *
+ *  - `pair`: `malloc` immediately followed by `free` of a small block
+ *  - `mixed`: random sizes (16 bytes to 4 KiB) replacing random members of a
+ *    set of live blocks, exercising splitting and coalescing
+ *  - `large`: blocks of 16 to 256 KiB
+ *  - `realloc`: growing a buffer in 1 KiB steps
+ *  - `new`: `new`/`delete` of a small object
+ */
+class HeapBenchmark : public Thread {
+	// Prevent copies and assignments
+	HeapBenchmark(const HeapBenchmark&)            = delete;
+	HeapBenchmark& operator=(const HeapBenchmark&) = delete;
+
+ public:
+	/*! \brief Constructor
+	 */
+	HeapBenchmark() {}
+
+	/*! \brief Contains the benchmark code.
+	 *
+	 */
+	void action() override;
+};
+
+extern HeapBenchmark heapbench[];
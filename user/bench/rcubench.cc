@@ -0,0 +1,79 @@
+#include "user/bench/rcubench.h"
+#include "debug/output.h"
+#include "interrupt/guarded.h"
+#include "machine/core.h"
+#include "machine/tsc.h"
+#include "sync/rcu.h"
+#include "syscall/guarded_scheduler.h"
+
+RCUBenchmark rcubench[Core::MAX]{};
+
+static const unsigned ELEMENTS = 64;
+static const unsigned LOOKUPS = 100000;
+
+static struct Element {
+    unsigned key;
+    Element* next;
+} element[ELEMENTS];
+
+static Element* list = nullptr;
+static volatile unsigned arrived = 0;
+
+static bool lookup(unsigned key) {
+    for (Element* e = RCU::dereference(list); e != nullptr; e = RCU::dereference(e->next))
+        if (e->key == key)
+            return true;
+    return false;
+}
+
+// wait until the benchmark threads on all cores are running
+static void barrier(unsigned round) {
+    __atomic_add_fetch(&arrived, 1, __ATOMIC_SEQ_CST);
+    while (arrived < round * Core::countOnline())
+        Core::pause();
+}
+
+void RCUBenchmark::action() {
+    if (this == &rcubench[0]) {
+        Guarded section;
+        for (unsigned i = 0; i < ELEMENTS; i++) {
+            element[i].key = i;
+            element[i].next = list;
+            RCU::assign(list, &element[i]);
+        }
+    } else {
+        while (RCU::dereference(list) == nullptr)
+            Core::pause();
+    }
+    if (static_cast<unsigned>(this - rcubench) >= Core::countOnline())
+        GuardedScheduler::exit();
+
+    unsigned seed = static_cast<unsigned>(this - rcubench) + 1;
+    unsigned found = 0;
+
+    barrier(1);
+    uint64_t start = TSC::read(TSC::CPUID_RDTSC);
+    for (unsigned i = 0; i < LOOKUPS; i++) {
+        seed = seed * 1103515245 + 12345;
+        RCU::readLock();
+        found += lookup((seed >> 16) % ELEMENTS);
+        RCU::readUnlock();
+    }
+    uint64_t rcu = TSC::read(TSC::RDTSCP_CPUID) - start;
+
+    barrier(2);
+    start = TSC::read(TSC::CPUID_RDTSC);
+    for (unsigned i = 0; i < LOOKUPS; i++) {
+        seed = seed * 1103515245 + 12345;
+        Guarded section;
+        found += lookup((seed >> 16) % ELEMENTS);
+    }
+    uint64_t guarded = TSC::read(TSC::RDTSCP_CPUID) - start;
+
+    {
+        Guarded section;
+        DBG << "lookup (" << found << "): rcu " << rcu / LOOKUPS
+            << " / guarded " << guarded / LOOKUPS << " cycles" << endl;
+    }
+    GuardedScheduler::exit();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "thread/thread.h"
+
+/*! \brief Read-scaling benchmark for \ref RCU
+ *
+ * One instance per core looks up random elements of a shared, read-mostly
+ * list -- once as lock-free \ref RCU reader and once inside a \ref Guarded
+ * section (the way the inode cache is protected) -- and prints the
+ * average cost per lookup in TSC cycles.
+ */
+class RCUBenchmark : public Thread {
+	// Prevent copies and assignments
+	RCUBenchmark(const RCUBenchmark&)            = delete;
+	RCUBenchmark& operator=(const RCUBenchmark&) = delete;
+
+ public:
+	/*! \brief Constructor
+	 */
+	RCUBenchmark() {}
+
+	/*! \brief Contains the benchmark code.
+	 *
+	 */
+	void action() override;
+};
+
+extern RCUBenchmark rcubench[];
@@ -0,0 +1,50 @@
+#include "user/bench/scanoutbench.h"
+#include "debug/output.h"
+#include "device/graphics.h"
+#include "interrupt/guarded.h"
+#include "machine/tsc.h"
+#include "syscall/guarded_scheduler.h"
+
+ScanoutBenchmark scanoutbench{};
+
+static const unsigned FRAMES = 32;
+
+// Buffers are allocated for the detected resolution
+static Graphics screen;
+
+// Average bandwidth of a scanout in MB/s
+static uint64_t measure() {
+    uint64_t cycles = 0;
+    for (unsigned i = 0; i < FRAMES; i++) {
+        screen.clear();
+        screen.switchBuffers();
+        uint64_t start = TSC::read(TSC::CPUID_RDTSC);
+        screen.scanoutFrontbuffer();
+        cycles += TSC::read(TSC::RDTSCP_CPUID) - start;
+    }
+    uint64_t ns = TSC::nanoseconds(cycles);
+    return ns > 0 ? static_cast<uint64_t>(screen.frameSize()) * FRAMES * 1000 / ns : 0;
+}
+
+void ScanoutBenchmark::action() {
+    if (!screen.init()) {
+        {
+            Guarded section;
+            DBG << "scanout: no supported video mode" << endl;
+        }
+        GuardedScheduler::exit();
+    }
+
+    bool wc = screen.writeCombining(false);
+    uint64_t write_back = measure();
+    wc = wc && screen.writeCombining(true);
+    uint64_t write_combining = measure();
+
+    {
+        Guarded section;
+        DBG << "scanout: " << screen.width() << "x" << screen.height() << " (" << screen.frameSize()
+            << " bytes), write back " << write_back << " MB/s, write-combining " << write_combining << " MB/s"
+            << (wc ? "" : " (mapping failed!)") << endl;
+    }
+    GuardedScheduler::exit();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "thread/thread.h"
+
+/*! \brief Scanout bandwidth benchmark for the \ref Graphics "linear frame buffer"
+ *
+ * Initializes a private \ref Graphics instance for the current video mode
+ * and measures \ref Graphics::scanoutFrontbuffer() with the video memory
+ * mapped write back (the default of the boot page tables) and
+ * write-combining, printing the average bandwidth in MB/s for both.
+ */
+class ScanoutBenchmark : public Thread {
+	// Prevent copies and assignments
+	ScanoutBenchmark(const ScanoutBenchmark&)            = delete;
+	ScanoutBenchmark& operator=(const ScanoutBenchmark&) = delete;
+
+ public:
+	/*! \brief Constructor
+	 */
+	ScanoutBenchmark() {}
+
+	/*! \brief Contains the benchmark code.
+	 *
+	 */
+	void action() override;
+};
+
+extern ScanoutBenchmark scanoutbench;
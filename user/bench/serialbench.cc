@@ -0,0 +1,32 @@
+#include "user/bench/serialbench.h"
+#include "debug/output.h"
+#include "device/serialdevice.h"
+#include "interrupt/guarded.h"
+#include "interrupt/irqstat.h"
+#include "machine/tsc.h"
+#include "thread/pollthread.h"
+
+SerialBenchmark serialbench{};
+
+static const unsigned BLOCK = 64 * 1024;
+
+void SerialBenchmark::action() {
+    while (true) {
+        Guarded section;
+        // the timing starts with the first byte of a block
+        serial.getChar();
+        uint64_t start = TSC::read();
+        uint64_t interrupts = IRQStat::total(Core::Interrupt::SERIAL);
+        uint64_t batches = pollthread.countBatches();
+        for (unsigned i = 1; i < BLOCK; i++)
+            serial.getChar();
+        uint64_t cycles = TSC::read() - start;
+        interrupts = IRQStat::total(Core::Interrupt::SERIAL) - interrupts;
+        batches = pollthread.countBatches() - batches;
+
+        DBG << "serial: " << cycles / BLOCK << " cycles/byte, "
+            << BLOCK / (interrupts > 0 ? interrupts : 1) << " bytes/irq, "
+            << BLOCK / (batches > 0 ? batches : 1) << " bytes/poll, "
+            << serial.lost() << " lost" << endl;
+    }
+}
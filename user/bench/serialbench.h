@@ -0,0 +1,28 @@
+#pragma once
+
+#include "thread/thread.h"
+
+/*! \brief Receive throughput benchmark for the \ref SerialDevice
+ *
+ * Consumes the bytes sent by `tools/serialflood.py` (via the pty of Qemu)
+ * and prints, for every block of received bytes, the cycles per byte as well
+ * as the number of bytes per serial interrupt and per \ref PollThread batch
+ * -- the latter showing the effect of the interrupt coalescing.
+ */
+class SerialBenchmark : public Thread {
+	// Prevent copies and assignments
+	SerialBenchmark(const SerialBenchmark&)            = delete;
+	SerialBenchmark& operator=(const SerialBenchmark&) = delete;
+
+ public:
+	/*! \brief Constructor
+	 */
+	SerialBenchmark() {}
+
+	/*! \brief Contains the benchmark code.
+	 *
+	 */
+	void action() override;
+};
+
+extern SerialBenchmark serialbench;
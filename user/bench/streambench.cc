@@ -0,0 +1,151 @@
+#include "user/bench/streambench.h"
+#include "debug/output.h"
+#include "interrupt/guarded.h"
+#include "machine/cache.h"
+#include "machine/core.h"
+#include "machine/tsc.h"
+#include "memory/pageframe.h"
+#include "syscall/guarded_scheduler.h"
+#include "utils/string.h"
+
+StreamBenchmark streambench[2]{};
+
+static const size_t COPY = 8 << 20;
+// Piece size for cached copies (memcpy would stream otherwise)
+static const size_t PIECE = 64 << 10;
+static const unsigned PASSES = 64;
+// Measurements of a phase before giving up on running on different cores
+static const unsigned ATTEMPTS = 16;
+
+enum Phase {
+    STARTING,
+    IDLE,
+    CACHED,
+    STREAMING,
+    DONE
+};
+
+static volatile Phase phase = STARTING;
+static volatile bool copier_ready = false;
+// Core the copier was last seen on
+static volatile unsigned copier_core = Core::MAX;
+// Copier statistics of the current phase
+static volatile uint64_t copied;
+static volatile uint64_t copy_cycles;
+
+static const char *name[] = {"", "idle", "cached copies", "streaming copies"};
+
+// Average cycles per pass over the working set
+static uint64_t read(const volatile uint64_t *data) {
+    uint64_t start = TSC::read(TSC::CPUID_RDTSC);
+    uint64_t sum = 0;
+    for (unsigned pass = 0; pass < PASSES; pass++)
+        for (size_t i = 0; i < StreamBenchmark::WORKING_SET / sizeof(uint64_t); i += CACHE_LINE_SIZE / sizeof(uint64_t))
+            sum += data[i];
+    uint64_t cycles = TSC::read(TSC::RDTSCP_CPUID) - start;
+    (void) sum;
+    return cycles / PASSES;
+}
+
+// The threads may migrate (or share a core) -- the results are only valid apart
+static bool apart() {
+    return Core::getID() != copier_core;
+}
+
+static void reader(uint64_t *data) {
+    for (size_t i = 0; i < StreamBenchmark::WORKING_SET / sizeof(uint64_t); i++)
+        data[i] = i;
+    while (!copier_ready)
+        Core::pause();
+
+    for (unsigned i = IDLE; i <= STREAMING; i++) {
+        Phase p = static_cast<Phase>(i);
+        uint64_t cycles = 0;
+        bool valid = false;
+        for (unsigned attempt = 0; attempt < ATTEMPTS && !valid; attempt++) {
+            if (!apart()) {
+                GuardedScheduler::resume();
+                continue;
+            }
+            copied = 0;
+            copy_cycles = 0;
+            phase = p;
+            read(data);  // warm up (and let the copier start)
+            cycles = read(data);
+            valid = apart();
+        }
+        if (!valid) {
+            Guarded section;
+            DBG << "stream: reader and copier share a core, aborted" << endl;
+            break;
+        }
+        uint64_t ns = TSC::nanoseconds(copy_cycles);
+        uint64_t bandwidth = ns > 0 ? copied * 1000 / ns : 0;
+
+        Guarded section;
+        DBG << "stream: " << name[p] << ": " << cycles << " cycles per pass over " << StreamBenchmark::WORKING_SET
+            << " B";
+        if (p != IDLE)
+            DBG << ", copying " << bandwidth << " MB/s";
+        DBG << endl;
+    }
+    phase = DONE;
+}
+
+static void copier(uint8_t *destination, const uint8_t *source) {
+    copier_core = Core::getID();
+    copier_ready = true;
+    Phase p;
+    while ((p = phase) != DONE) {
+        copier_core = Core::getID();
+        if (p != CACHED && p != STREAMING) {
+            Core::pause();
+            continue;
+        }
+        uint64_t start = TSC::read();
+        if (p == CACHED) {
+            for (size_t offset = 0; offset < COPY; offset += PIECE)
+                memcpy(destination + offset, source + offset, PIECE);
+        } else {
+            memcpy_stream(destination, source, COPY);
+        }
+        uint64_t cycles = TSC::read() - start;
+        if (phase == p) {
+            copied += COPY;
+            copy_cycles += cycles;
+        }
+    }
+}
+
+void StreamBenchmark::action() {
+    unsigned id = static_cast<unsigned>(this - streambench);
+    if (Core::countOnline() < 2) {
+        if (id == 0) {
+            Guarded section;
+            DBG << "stream: requires two cores" << endl;
+        }
+        GuardedScheduler::exit();
+    }
+
+    unsigned order = PageFrame::order(id == 0 ? WORKING_SET : 2 * COPY);
+    void *memory = PageFrame::allocate(order);
+    if (memory == nullptr) {
+        {
+            Guarded section;
+            DBG << "stream: not enough memory" << endl;
+        }
+        phase = DONE;
+        copier_ready = true;
+        GuardedScheduler::exit();
+    }
+
+    if (id == 0) {
+        reader(reinterpret_cast<uint64_t *>(memory));
+    } else {
+        uint8_t *source = reinterpret_cast<uint8_t *>(memory);
+        memset(source, 0x5a, COPY);
+        copier(source + COPY, source);
+    }
+    PageFrame::free(memory, order);
+    GuardedScheduler::exit();
+}
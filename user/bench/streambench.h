@@ -0,0 +1,34 @@
+#pragma once
+
+#include "thread/thread.h"
+
+/*! \brief Side-by-side benchmark of cached and non-temporal copies
+ *
+ * Two instances run concurrently (on different cores): The first one
+ * repeatedly reads a working set of \ref WORKING_SET bytes and measures the
+ * time per pass, while the second one is idle, copies 8 MiB buffers with
+ * regular stores (in pieces below \ref MEMCPY_STREAM_THRESHOLD) or with
+ * \ref memcpy_stream. The slowdown of the reader shows how much of its cached
+ * data the copies displace; the copy bandwidth is printed as well.
+ * A measurement is repeated if both threads were found on the same core.
+ */
+class StreamBenchmark : public Thread {
+	// Prevent copies and assignments
+	StreamBenchmark(const StreamBenchmark&)            = delete;
+	StreamBenchmark& operator=(const StreamBenchmark&) = delete;
+
+ public:
+	/// Size of the data read by the first instance
+	static const size_t WORKING_SET = 1 << 20;
+
+	/*! \brief Constructor
+	 */
+	StreamBenchmark() {}
+
+	/*! \brief Contains the benchmark code.
+	 *
+	 */
+	void action() override;
+};
+
+extern StreamBenchmark streambench[2];
@@ -0,0 +1,78 @@
+#include "user/bench/stringbench.h"
+#include "debug/output.h"
+#include "interrupt/guarded.h"
+#include "machine/cpuid.h"
+#include "machine/tsc.h"
+#include "memory/pageframe.h"
+#include "syscall/guarded_scheduler.h"
+#include "utils/string.h"
+
+StringBenchmark stringbench{};
+
+static const size_t MIN = 8;
+static const size_t MAX = 8 << 20;
+// Bytes processed per size and function (at least one call)
+static const size_t VOLUME = 32 << 20;
+
+static volatile int sink;
+
+// Reference: what the functions did before
+static void byteCopy(uint8_t *destination, const uint8_t *source, size_t size) {
+    for (size_t i = 0; i != size; ++i)
+        destination[i] = source[i];
+}
+
+// Bandwidth in MB/s for `rounds` times `size` bytes in `cycles`
+static uint64_t bandwidth(size_t size, size_t rounds, uint64_t cycles) {
+    uint64_t ns = TSC::nanoseconds(cycles);
+    return ns > 0 ? static_cast<uint64_t>(size) * rounds * 1000 / ns : 0;
+}
+
+template<typename F>
+static uint64_t measure(size_t size, F f) {
+    size_t rounds = VOLUME / size;
+    uint64_t start = TSC::read(TSC::CPUID_RDTSC);
+    for (size_t i = 0; i < rounds; i++)
+        f();
+    return bandwidth(size, rounds, TSC::read(TSC::RDTSCP_CPUID) - start);
+}
+
+void StringBenchmark::action() {
+    unsigned order = PageFrame::order(MAX + PageFrame::SIZE);
+    uint8_t *source = reinterpret_cast<uint8_t *>(PageFrame::allocate(order));
+    uint8_t *destination = reinterpret_cast<uint8_t *>(PageFrame::allocate(order));
+    if (source == nullptr || destination == nullptr) {
+        PageFrame::free(source, order);
+        PageFrame::free(destination, order);
+        {
+            Guarded section;
+            DBG << "string: not enough memory" << endl;
+        }
+        GuardedScheduler::exit();
+    }
+    for (size_t i = 0; i < MAX; i++)
+        source[i] = static_cast<uint8_t>(i * 7);
+
+    {
+        Guarded section;
+        DBG << "string: ERMS " << (CPUID::has(CPUID::STRUCTURED_FEATURE_ERMS) ? "yes" : "no")
+            << ", MB/s for memcpy (byte loop), memmove, memset, memcmp" << endl;
+    }
+    for (size_t size = MIN; size <= MAX; size *= 4) {
+        uint64_t copy = measure(size, [&] { memcpy(destination, source, size); });
+        uint64_t bytes = measure(size, [&] { byteCopy(destination, source, size); });
+        // overlapping, the destination above the source (copied backwards)
+        uint64_t move = measure(size, [&] { memmove(destination + 1, destination, size); });
+        uint64_t set = measure(size, [&] { memset(destination, static_cast<int>(size), size); });
+        memcpy(destination, source, size);
+        uint64_t compare = measure(size, [&] { sink = memcmp(destination, source, size); });
+
+        Guarded section;
+        DBG << "string: " << size << " B: " << copy << " (" << bytes << "), " << move << ", "
+            << set << ", " << compare << endl;
+    }
+
+    PageFrame::free(source, order);
+    PageFrame::free(destination, order);
+    GuardedScheduler::exit();
+}
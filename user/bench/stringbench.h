@@ -0,0 +1,27 @@
+#pragma once
+
+#include "thread/thread.h"
+
+/*! \brief Throughput benchmark for the memory functions of `utils/string.h`
+ *
+ * Measures \ref memcpy (compared to a byte-wise loop), \ref memmove (with
+ * overlapping buffers), \ref memset and \ref memcmp for sizes from 8 bytes
+ * to 8 MiB and prints the bandwidth in MB/s for each size.
+ */
+class StringBenchmark : public Thread {
+	// Prevent copies and assignments
+	StringBenchmark(const StringBenchmark&)            = delete;
+	StringBenchmark& operator=(const StringBenchmark&) = delete;
+
+ public:
+	/*! \brief Constructor
+	 */
+	StringBenchmark() {}
+
+	/*! \brief Contains the benchmark code.
+	 *
+	 */
+	void action() override;
+};
+
+extern StringBenchmark stringbench;
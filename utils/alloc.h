@@ -1,5 +1,7 @@
 /*! \file
  *  \brief C-style dynamic memory allocation interface
+ *
+ *  Implemented by the kernel \ref Heap (`memory/heap.cc`).
  */
 
 #pragma once
@@ -12,14 +14,22 @@
  * \param size Requested size of memory in bytes.
  * \return Pointer to memory or `nullptr` on error (no memory available) or if size
  *         was zero.
- * \opt Implement method
  */
 extern "C" void *malloc(size_t size);
 
+/*! \brief Allocate an aligned memory block
+ * The memory is not initialized.
+ *
+ * \param alignment Alignment in bytes (a power of two)
+ * \param size Requested size of memory in bytes.
+ * \return Pointer to memory (a multiple of `alignment`) or `nullptr` on error
+ *         (no memory available, invalid alignment) or if size was zero.
+ */
+extern "C" void *aligned_alloc(size_t alignment, size_t size);
+
 /*! \brief Free an allocated memory block
  *
  * \param ptr Pointer to an previously allocated memory block.
- * \opt Implement method
  */
 extern "C" void free(void *ptr);
 
@@ -33,7 +43,6 @@ extern "C" void free(void *ptr);
  * \param size New size of the memory block. If equal to zero, then the call
  *             is equivalent to free
  * \return Pointer to new memory block or `nullptr` on error
- * \opt Implement method
  */
 extern "C" void *realloc(void *ptr, size_t size);
 
@@ -43,6 +52,5 @@ extern "C" void *realloc(void *ptr, size_t size);
  * \param nmemb Number of elements
  * \param size Size of an element in bytes
  * \return pointer to the allocated memory or `nullptr` if the request fails
- * \opt Implement method
  */
 extern "C" void *calloc(size_t nmemb, size_t size);
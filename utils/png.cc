@@ -32,6 +32,7 @@
  */
 #include "utils/png.h"
 #include "utils/alloc.h"
+#include "memory/arena.h"
 #include "utils/string.h"
 #include "fs/vfs.h"
 
@@ -1008,8 +1009,12 @@ enum PNG::error PNG::decode() {
 		chunk += chunk_length(chunk) + 12;
 	}
 
+	// the intermediate buffers are released with the scope
+	Arena &scratch = Arena::scratch();
+	Arena::Scope scope(scratch);
+
 	// allocate enough space for the (compressed and filtered) image data
-	unsigned char* compressed = compressed_size == 0 ? nullptr : static_cast<unsigned char*>(malloc(compressed_size));
+	unsigned char* compressed = compressed_size == 0 ? nullptr : static_cast<unsigned char*>(scratch.allocate(compressed_size, 1));
 	if (compressed == nullptr) {
 		SET_ERROR(PNG_ENOMEM);
 		return error;
@@ -1035,9 +1040,8 @@ enum PNG::error PNG::decode() {
 
 	// allocate space to store inflated (but still filtered) data
 	unsigned long inflated_size = ((width * (height * get_bpp() + 7)) / 8) + height;
-	unsigned char* inflated = static_cast<unsigned char*>(malloc(inflated_size));
+	unsigned char* inflated = static_cast<unsigned char*>(scratch.allocate(inflated_size, 1));
 	if (inflated == nullptr) {
-		free(compressed);
 		SET_ERROR(PNG_ENOMEM);
 		return error;
 	}
@@ -1045,19 +1049,13 @@ enum PNG::error PNG::decode() {
 	// decompress image data
 	enum error err = uz_inflate(inflated, inflated_size, compressed, compressed_size);
 	if (err != PNG_EOK) {
-		free(compressed);
-		free(inflated);
 		return error;
 	}
 
-	// free the compressed compressed data
-	free(compressed);
-
 	// allocate final image buffer
 	size = (height * width * get_bpp() + 7) / 8;
 	buffer = static_cast<unsigned char*>(malloc(size));
 	if (buffer == nullptr) {
-		free(inflated);
 		size = 0;
 		SET_ERROR(PNG_ENOMEM);
 		return error;
@@ -1065,7 +1063,6 @@ enum PNG::error PNG::decode() {
 
 	// unfilter scanlines
 	post_process_scanlines(buffer, inflated, this);
-	free(inflated);
 
 	if (error != PNG_EOK) {
 		free(buffer);
@@ -1098,10 +1095,21 @@ PNG::PNG(const char* path) : width(0), height(0), color_type(COLOR_RGBA), color_
 	int fd = VFS::open(path, O_RDONLY);
 	struct stat statbuf;
 	unsigned char * buf;
+	const void * mapped = nullptr;
 	if (fd < 0) {
 		SET_ERROR(PNG_ENOTFOUND);
 	} else if (VFS::fstat(fd, &statbuf) != 0) {
 		SET_ERROR(PNG_EIOERROR);
+	} else if (statbuf.st_size > 0 && VFS::map(fd, 0, statbuf.st_size, &mapped) == statbuf.st_size) {
+		// the file is stored contiguously in memory (e.g. on a ramdisk): decode in place
+		if (VFS::close(fd) != 0) {
+			SET_ERROR(PNG_EIOERROR);
+		} else {
+			source.buffer = static_cast<const unsigned char*>(mapped);
+			source.size = statbuf.st_size;
+			source.owning = 0;
+			error = header();
+		}
 	} else if ((buf = static_cast<unsigned char*>(malloc(statbuf.st_size + 1))) == nullptr) {
 		SET_ERROR(PNG_ENOMEM);
 	} else {
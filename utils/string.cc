@@ -1,5 +1,6 @@
 #include "string.h"
 #include "types.h"
+#include "machine/cpuid.h"
 
 extern "C" char *strchrnul(const char *s, int c) {
 	if (s != nullptr) {
@@ -92,13 +93,82 @@ extern "C" char * strncpy(char *dest, const char *src, size_t n) {
 	return r;
 }
 
+// Unaligned word access (which may alias anything)
+typedef uint64_t __attribute__((may_alias, aligned(1))) word_t;
+
+// From this size on, string instructions are faster than the word loops
+static const size_t REP_THRESHOLD = 256;
+
+// Whether `rep movsb`/`rep stosb` are fast (ERMS); determined on first use
+static bool fastStrings() {
+	static int8_t erms = -1;
+	int8_t value = __atomic_load_n(&erms, __ATOMIC_RELAXED);
+	if (value < 0) {
+		value = CPUID::has(CPUID::STRUCTURED_FEATURE_ERMS) ? 1 : 0;
+		__atomic_store_n(&erms, value, __ATOMIC_RELAXED);
+	}
+	return value != 0;
+}
+
+// Forward copy, safe for overlapping buffers with the destination below the source
+static void copyForward(uint8_t *destination, const uint8_t *source, size_t size) {
+	if (size >= REP_THRESHOLD) {
+		if (!fastStrings()) {
+			size_t words = size / sizeof(uint64_t);
+			asm volatile("rep movsq" : "+D"(destination), "+S"(source), "+c"(words) : : "memory");
+			size %= sizeof(uint64_t);
+		}
+		asm volatile("rep movsb" : "+D"(destination), "+S"(source), "+c"(size) : : "memory");
+		return;
+	}
+	for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+		*reinterpret_cast<word_t*>(destination) = *reinterpret_cast<const word_t*>(source);
+		destination += sizeof(uint64_t);
+		source += sizeof(uint64_t);
+	}
+	while (size-- != 0) {
+		*destination++ = *source++;
+	}
+}
+
 extern "C" void* memcpy(void * __restrict__ dest, void const * __restrict__ src, size_t size) {
+	if (size >= MEMCPY_STREAM_THRESHOLD) {
+		return memcpy_stream(dest, src, size);
+	}
+	copyForward(reinterpret_cast<uint8_t*>(dest), reinterpret_cast<uint8_t const*>(src), size);
+	return dest;
+}
+
+extern "C" void* memcpy_stream(void * __restrict__ dest, void const * __restrict__ src, size_t size) {
 	uint8_t *destination = reinterpret_cast<uint8_t*>(dest);
-	uint8_t const *source = (uint8_t const*)src;
+	uint8_t const *source = reinterpret_cast<uint8_t const*>(src);
 
-	for(size_t i = 0; i != size; ++i) {
-		destination[i] = source[i];
+	// align the destination, so the stores fill whole lines of the write-combining buffers
+	while (size != 0 && (reinterpret_cast<uintptr_t>(destination) % sizeof(uint64_t)) != 0) {
+		*destination++ = *source++;
+		size--;
+	}
+	uint64_t *to = reinterpret_cast<uint64_t*>(destination);
+	for (; size >= 4 * sizeof(uint64_t); size -= 4 * sizeof(uint64_t)) {
+		const word_t *from = reinterpret_cast<const word_t*>(source);
+		uint64_t a = from[0], b = from[1], c = from[2], d = from[3];
+		asm volatile("movnti %1, %0" : "=m"(to[0]) : "r"(a));
+		asm volatile("movnti %1, %0" : "=m"(to[1]) : "r"(b));
+		asm volatile("movnti %1, %0" : "=m"(to[2]) : "r"(c));
+		asm volatile("movnti %1, %0" : "=m"(to[3]) : "r"(d));
+		to += 4;
+		source += 4 * sizeof(uint64_t);
+	}
+	for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+		asm volatile("movnti %1, %0" : "=m"(*to++) : "r"(*reinterpret_cast<const word_t*>(source)));
+		source += sizeof(uint64_t);
 	}
+	destination = reinterpret_cast<uint8_t*>(to);
+	while (size-- != 0) {
+		*destination++ = *source++;
+	}
+	// non-temporal stores are weakly ordered
+	asm volatile("sfence" : : : "memory");
 
 	return dest;
 }
@@ -107,13 +177,19 @@ extern "C" void* memmove(void * dest, void const * src, size_t size) {
 	uint8_t *destination = reinterpret_cast<uint8_t*>(dest);
 	uint8_t const *source = reinterpret_cast<uint8_t const*>(src);
 
-	if(source > destination) {
-		for(size_t i = 0; i != size; ++i) {
-			destination[i] = source[i];
-		}
+	if (destination <= source || destination >= source + size) {
+		copyForward(destination, source, size);
 	} else {
-		for(size_t i = size; i != 0; --i) {
-			destination[i-1] = source[i-1];
+		// backwards (the direction flag variants of the string instructions are slow)
+		destination += size;
+		source += size;
+		for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+			destination -= sizeof(uint64_t);
+			source -= sizeof(uint64_t);
+			*reinterpret_cast<word_t*>(destination) = *reinterpret_cast<const word_t*>(source);
+		}
+		while (size-- != 0) {
+			*--destination = *--source;
 		}
 	}
 
@@ -122,9 +198,23 @@ extern "C" void* memmove(void * dest, void const * src, size_t size) {
 
 extern "C" void* memset(void *dest, int pattern, size_t size) {
 	uint8_t *destination = reinterpret_cast<uint8_t*>(dest);
+	uint64_t word = static_cast<uint8_t>(pattern) * 0x0101010101010101ULL;
 
-	for(size_t i = 0; i != size; ++i) {
-		destination[i] = static_cast<uint8_t>(pattern);
+	if (size >= REP_THRESHOLD) {
+		if (!fastStrings()) {
+			size_t words = size / sizeof(uint64_t);
+			asm volatile("rep stosq" : "+D"(destination), "+c"(words) : "a"(word) : "memory");
+			size %= sizeof(uint64_t);
+		}
+		asm volatile("rep stosb" : "+D"(destination), "+c"(size) : "a"(word) : "memory");
+		return dest;
+	}
+	for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+		*reinterpret_cast<word_t*>(destination) = word;
+		destination += sizeof(uint64_t);
+	}
+	while (size-- != 0) {
+		*destination++ = static_cast<uint8_t>(pattern);
 	}
 
 	return dest;
@@ -134,7 +224,16 @@ extern "C" int memcmp(const void * s1, const void * s2, size_t n) {
 	const unsigned char * c1 = reinterpret_cast<const unsigned char*>(s1);
 	const unsigned char * c2 = reinterpret_cast<const unsigned char*>(s2);
 
-	for(size_t i = 0; i != n; ++i) {
+	size_t i = 0;
+	for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+		uint64_t difference = *reinterpret_cast<const word_t*>(c1 + i) ^ *reinterpret_cast<const word_t*>(c2 + i);
+		if (difference != 0) {
+			// little endian: the lowest set bit belongs to the first differing byte
+			i += __builtin_ctzll(difference) / 8;
+			return static_cast<int>(c1[i]) - static_cast<int>(c2[i]);
+		}
+	}
+	for (; i != n; ++i) {
 		if (c1[i] != c2[i]) {
 			return static_cast<int>(c1[i]) - static_cast<int>(c2[i]);
 		}
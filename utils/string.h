@@ -89,9 +89,34 @@ extern "C" char * strncpy(char * dest, const char * src, size_t n);
  * \param size number of bytes to copy
  * \return pointer to destination
  * \note The memory must not overlap!
+ * \note Copies of at least \ref MEMCPY_STREAM_THRESHOLD bytes are done by
+ *       \ref memcpy_stream
  */
 extern "C" void* memcpy(void * __restrict__ dest, void const * __restrict__ src, size_t size);
 
+/*! \brief Size from which on \ref memcpy uses \ref memcpy_stream
+ * \ingroup string
+ *
+ * Such copies would replace most of the caches' contents anyway.
+ */
+const size_t MEMCPY_STREAM_THRESHOLD = 1 << 20;
+
+/*! \brief Copy a memory area bypassing the caches
+ *
+ * Uses non-temporal stores (`movnti`), which neither allocate nor evict
+ * cache lines, for the destination -- preferable for large copies whose
+ * destination is not read soon (e.g. to the frame buffer) as they do not
+ * displace the working set of the cores. The stores are fenced before the
+ * function returns.
+ * \ingroup string
+ * \param dest destination buffer
+ * \param src source buffer
+ * \param size number of bytes to copy
+ * \return pointer to destination
+ * \note The memory must not overlap!
+ */
+extern "C" void* memcpy_stream(void * __restrict__ dest, void const * __restrict__ src, size_t size);
+
 /*! \brief Copy a memory area
  * while the source may overlap with the destination
  * \ingroup string